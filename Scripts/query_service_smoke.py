@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Smoke test for the Hard Reference Finder query service.
+
+Run it against an editor with HardReferenceFinder.QueryService.Enable 1:
+
+    python3 Scripts/query_service_smoke.py /Game/Characters/BP_Hero --port 8765 --limit 25
+
+Pages through the closure of the package with GET requests and checks the paging fields, then asks for the same pages
+in one POST batch and checks both agree. Exits with a non-zero status on the first failed check.
+"""
+
+import argparse
+import json
+import sys
+import urllib.parse
+import urllib.request
+
+
+def get(base_url, params):
+    with urllib.request.urlopen(base_url + "?" + urllib.parse.urlencode(params)) as response:
+        return json.load(response)["results"][0]
+
+
+def post(base_url, queries):
+    request = urllib.request.Request(base_url, data=json.dumps({"queries": queries}).encode("utf-8"), method="POST")
+    with urllib.request.urlopen(request) as response:
+        return json.load(response)["results"]
+
+
+def check(condition, message):
+    if not condition:
+        print("FAILED: " + message)
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("package", help="long package name whose closure is paged through, e.g. /Game/Characters/BP_Hero")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--limit", type=int, default=25, help="page size, small enough to need several pages")
+    args = parser.parse_args()
+    base_url = "http://%s:%d/hardreferences" % (args.host, args.port)
+
+    pages = []
+    offset = 0
+    total = None
+    while offset != -1:
+        page = get(base_url, {"type": "closure", "package": args.package, "offset": offset, "limit": args.limit})
+        check("error" not in page, "query failed: %s" % page.get("error"))
+        check(total is None or page["total"] == total, "total changed between pages")
+        total = page["total"]
+        check(page["offset"] == offset, "page at %d reports offset %d" % (offset, page["offset"]))
+        check(len(page["packages"]) <= args.limit, "page at %d holds more than %d packages" % (offset, args.limit))
+
+        expected_next = offset + len(page["packages"])
+        if expected_next < total:
+            check(len(page["packages"]) == args.limit, "page at %d is short but not the last one" % offset)
+            check(page["nextOffset"] == expected_next, "page at %d reports nextOffset %d" % (offset, page["nextOffset"]))
+        else:
+            check(page["nextOffset"] == -1, "last page reports nextOffset %d" % page["nextOffset"])
+        pages.append(page)
+        offset = page["nextOffset"]
+
+    packages = [package["package"] for page in pages for package in page["packages"]]
+    check(len(packages) == total, "pages hold %d packages, total is %d" % (len(packages), total))
+    check(len(set(packages)) == total, "pages repeat packages")
+    check(args.package in packages, "the closure doesn't contain the package itself")
+
+    past_end = get(base_url, {"type": "closure", "package": args.package, "offset": total + 10, "limit": args.limit})
+    check(past_end["offset"] == total and past_end["packages"] == [] and past_end["nextOffset"] == -1, "offset past the end isn't clamped")
+
+    batch = post(base_url, [{"type": "closure", "package": args.package, "offset": page["offset"], "limit": args.limit} for page in pages])
+    check(len(batch) == len(pages), "batch returned %d results for %d queries" % (len(batch), len(pages)))
+    for page, batch_page in zip(pages, batch):
+        check(page == batch_page, "batch page at %d differs from the GET page" % page["offset"])
+
+    print("OK: %d packages in %d pages of %d" % (total, len(pages), args.limit))
+
+
+if __name__ == "__main__":
+    main()
@@ -45,7 +45,17 @@ public class HardReferenceFinder : ModuleRules
 				"Kismet",
 				"AssetRegistry",
 				"BlueprintGraph",
+				"GraphEditor",
 				"AssetTools",
+				"ContentBrowser",
+				"DesktopPlatform",
+				"WorkspaceMenuStructure",
+				"UMG",
+				"UMGEditor",
+				"TreeMap",
+				"HTTPServer",
+				"Json",
+				"TargetPlatform",
 			}
 			);
 
@@ -1,12 +1,38 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "HardReferenceFinder.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderCookReport.h"
+#include "HardReferenceFinderQueryService.h"
+#include "HardReferenceFinderScheduler.h"
+#include "HardReferenceFinderTrendStore.h"
 #include "HardReferenceFinderStyle.h"
 #include "WorkflowOrientedApp/WorkflowTabManager.h"
+#include "ContentBrowserModule.h"
+#include "Editor.h"
+#include "Engine/DataAsset.h"
+#include "Engine/DataTable.h"
+#include "Materials/MaterialInterface.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Toolkits/AssetEditorToolkit.h"
 #include "BlueprintEditor.h"
 #include "HardReferenceFinderSummoner.h"
+#include "SHardReferenceFinderAggregate.h"
+#include "SHardReferenceFinderHeatmap.h"
+#include "SHardReferenceFinderWindow.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Framework/MultiBox/MultiBoxExtender.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 static const FName HardReferenceFinderTabName("HardReferenceFinder");
+static const FName LevelHardReferenceFinderTabName("LevelHardReferenceFinder");
+static const FName AssetHardReferenceFinderTabName("AssetHardReferenceFinder");
+static const FName HardReferenceHeatmapTabName("HardReferenceHeatmap");
+static const FName HardReferenceAggregateTabName("HardReferenceAggregate");
 
 #define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
 
@@ -14,14 +40,76 @@ void FHardReferenceFinderModule::StartupModule()
 {
 	FHardReferenceFinderStyle::Initialize();
 	FHardReferenceFinderStyle::ReloadTextures();
+	FHardReferenceFinderCache::Initialize();
+	FHardReferenceFinderScheduler::Initialize();
+	FHardReferenceFinderQueryService::Initialize();
+	FHardReferenceFinderTrendStore::Initialize();
+	FHardReferenceFinderCookReport::Initialize();
 
 	FBlueprintEditorModule& BlueprintEditorModule = FModuleManager::LoadModuleChecked<FBlueprintEditorModule>("Kismet");
 	BlueprintEditorModule.OnRegisterTabsForEditor().AddRaw(this, &FHardReferenceFinderModule::RegisterBlueprintTabs);
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(LevelHardReferenceFinderTabName, FOnSpawnTab::CreateRaw(this, &FHardReferenceFinderModule::SpawnLevelTab))
+		.SetDisplayName(LOCTEXT("LevelTabTitle", "Level Hard References"))
+		.SetTooltipText(LOCTEXT("LevelTabTooltip", "Shows the level script nodes and placed actors that hard reference other packages"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetLevelEditorCategory())
+		.SetIcon(FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer"));
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(HardReferenceHeatmapTabName, FOnSpawnTab::CreateRaw(this, &FHardReferenceFinderModule::SpawnHeatmapTab))
+		.SetDisplayName(LOCTEXT("HeatmapTabTitle", "Hard Reference Heatmap"))
+		.SetTooltipText(LOCTEXT("HeatmapTabTooltip", "Shows the hard dependency count and closure size of every blueprint in the project"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsAuditCategory())
+		.SetIcon(FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer"));
+
+	// Only opened from the Content Browser, which hands it the selected assets
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(HardReferenceAggregateTabName, FOnSpawnTab::CreateRaw(this, &FHardReferenceFinderModule::SpawnAggregateTab))
+		.SetDisplayName(LOCTEXT("AggregateTabTitle", "Combined Hard References"))
+		.SetMenuType(ETabSpawnerMenuType::Hidden)
+		.SetIcon(FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer"));
+
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+	FContentBrowserMenuExtender_SelectedAssets ContentBrowserExtender = FContentBrowserMenuExtender_SelectedAssets::CreateRaw(this, &FHardReferenceFinderModule::ExtendContentBrowserMenu);
+	ContentBrowserExtenderHandle = ContentBrowserExtender.GetHandle();
+	ContentBrowserModule.GetAllAssetViewContextMenuExtenders().Add(ContentBrowserExtender);
+
+	// Asset editors other than the blueprint editor don't expose their tab factories, so a menu entry is added to
+	// every asset editor which docks the panel into that editor's own tab manager.
+	FAssetEditorExtender AssetEditorExtender = FAssetEditorExtender::CreateRaw(this, &FHardReferenceFinderModule::ExtendAssetEditorMenu);
+	AssetEditorExtenderHandle = AssetEditorExtender.GetHandle();
+	FAssetEditorToolkit::GetSharedMenuExtensibilityManager()->GetExtenderDelegates().Add(AssetEditorExtender);
 }
 
 void FHardReferenceFinderModule::ShutdownModule()
 {
 	FHardReferenceFinderStyle::Shutdown();
+	FHardReferenceFinderCookReport::Shutdown();
+	FHardReferenceFinderTrendStore::Shutdown();
+	FHardReferenceFinderQueryService::Shutdown();
+	FHardReferenceFinderScheduler::Shutdown();
+	FHardReferenceFinderCache::Shutdown();
+
+	if(FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(LevelHardReferenceFinderTabName);
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(HardReferenceHeatmapTabName);
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(HardReferenceAggregateTabName);
+	}
+
+	if(FContentBrowserModule* ContentBrowserModule = FModuleManager::GetModulePtr<FContentBrowserModule>(TEXT("ContentBrowser")))
+	{
+		ContentBrowserModule->GetAllAssetViewContextMenuExtenders().RemoveAll([this](const FContentBrowserMenuExtender_SelectedAssets& Delegate)
+		{
+			return Delegate.GetHandle() == ContentBrowserExtenderHandle;
+		});
+	}
+
+	if(TSharedPtr<FExtensibilityManager> MenuExtensibilityManager = FAssetEditorToolkit::GetSharedMenuExtensibilityManager())
+	{
+		MenuExtensibilityManager->GetExtenderDelegates().RemoveAll([this](const FAssetEditorExtender& Delegate)
+		{
+			return Delegate.GetHandle() == AssetEditorExtenderHandle;
+		});
+	}
 	
 	FBlueprintEditorModule& BlueprintEditorModule = FModuleManager::LoadModuleChecked<FBlueprintEditorModule>("Kismet");
 	BlueprintEditorModule.OnRegisterTabsForEditor().RemoveAll(this);
@@ -32,6 +120,122 @@ void FHardReferenceFinderModule::RegisterBlueprintTabs(FWorkflowAllowedTabSet& T
 	TabFactory.RegisterFactory(MakeShareable(new FHardReferenceFinderSummoner(InBlueprintEditor)));
 }
 
+TSharedRef<SDockTab> FHardReferenceFinderModule::SpawnLevelTab(const FSpawnTabArgs& SpawnTabArgs) const
+{
+	const TSharedRef<SHardReferenceFinderWindow> Window = SNew(SHardReferenceFinderWindow, nullptr)
+		.AnalyzeEditorWorld(true);
+	const TSharedRef<SDockTab> Tab = SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			Window
+		];
+	Window->SetOwnerTab(Tab);
+	return Tab;
+}
+
+TSharedRef<SDockTab> FHardReferenceFinderModule::SpawnHeatmapTab(const FSpawnTabArgs& SpawnTabArgs) const
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SHardReferenceFinderHeatmap)
+		];
+}
+
+TSharedRef<SDockTab> FHardReferenceFinderModule::SpawnAggregateTab(const FSpawnTabArgs& SpawnTabArgs) const
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SHardReferenceFinderAggregate)
+		];
+}
+
+TSharedRef<FExtender> FHardReferenceFinderModule::ExtendContentBrowserMenu(const TArray<FAssetData>& SelectedAssets) const
+{
+	TSharedRef<FExtender> Extender = MakeShared<FExtender>();
+	if(SelectedAssets.Num() < 2)
+	{
+		return Extender;
+	}
+
+	Extender->AddMenuExtension("GetAssetActions", EExtensionHook::After, nullptr, FMenuExtensionDelegate::CreateLambda([SelectedAssets](FMenuBuilder& MenuBuilder)
+	{
+		MenuBuilder.AddMenuEntry(
+			LOCTEXT("AggregateMenuEntry", "Combined Hard References"),
+			LOCTEXT("AggregateMenuEntryTooltip", "Shows the combined hard reference closure of the selected assets, and how much of it each asset shares with the others"),
+			FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer"),
+			FUIAction(FExecuteAction::CreateStatic(&FHardReferenceFinderModule::OpenAggregateTab, SelectedAssets)));
+	}));
+	return Extender;
+}
+
+void FHardReferenceFinderModule::OpenAggregateTab(TArray<FAssetData> SelectedAssets)
+{
+	if(const TSharedPtr<SDockTab> Tab = FGlobalTabmanager::Get()->TryInvokeTab(HardReferenceAggregateTabName))
+	{
+		const TSharedRef<SHardReferenceFinderAggregate> Aggregate = StaticCastSharedRef<SHardReferenceFinderAggregate>(Tab->GetContent());
+		Aggregate->SetAssets(SelectedAssets);
+	}
+}
+
+TSharedRef<FExtender> FHardReferenceFinderModule::ExtendAssetEditorMenu(const TSharedRef<FUICommandList> CommandList, const TArray<UObject*> EditingObjects) const
+{
+	TSharedRef<FExtender> Extender = MakeShared<FExtender>();
+
+	// Blueprints already get a tab through the blueprint editor's own tab factories
+	UObject* Asset = EditingObjects.Num() > 0 ? EditingObjects[0] : nullptr;
+	const bool bIsSupportedAsset = Asset && (Asset->IsA<UDataTable>() || Asset->IsA<UDataAsset>() || Asset->IsA<UMaterialInterface>());
+	if(!bIsSupportedAsset)
+	{
+		return Extender;
+	}
+
+	TWeakObjectPtr<UObject> WeakAsset = Asset;
+	Extender->AddMenuExtension("AssetEditorActions", EExtensionHook::After, CommandList, FMenuExtensionDelegate::CreateLambda([WeakAsset](FMenuBuilder& MenuBuilder)
+	{
+		MenuBuilder.AddMenuEntry(
+			LOCTEXT("AssetTabMenuEntry", "Hard References"),
+			LOCTEXT("AssetTabMenuEntryTooltip", "Shows the rows and properties of this asset that hard reference other packages"),
+			FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer"),
+			FUIAction(FExecuteAction::CreateStatic(&FHardReferenceFinderModule::OpenAssetEditorTab, WeakAsset)));
+	}));
+	return Extender;
+}
+
+void FHardReferenceFinderModule::OpenAssetEditorTab(TWeakObjectPtr<UObject> Asset)
+{
+	if(!Asset.IsValid() || GEditor == nullptr)
+	{
+		return;
+	}
+
+	IAssetEditorInstance* AssetEditor = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->FindEditorForAsset(Asset.Get(), false);
+	const TSharedPtr<FTabManager> TabManager = AssetEditor ? AssetEditor->GetAssociatedTabManager() : nullptr;
+	if(!TabManager.IsValid())
+	{
+		return;
+	}
+
+	if(!TabManager->HasTabSpawner(AssetHardReferenceFinderTabName))
+	{
+		TabManager->RegisterTabSpawner(AssetHardReferenceFinderTabName, FOnSpawnTab::CreateLambda([Asset](const FSpawnTabArgs& SpawnTabArgs)
+		{
+			const TSharedRef<SHardReferenceFinderWindow> Window = SNew(SHardReferenceFinderWindow, nullptr)
+				.Asset(Asset.Get());
+			const TSharedRef<SDockTab> Tab = SNew(SDockTab)
+				[
+					Window
+				];
+			Window->SetOwnerTab(Tab);
+			return Tab;
+		}))
+		.SetDisplayName(LOCTEXT("AssetTabTitle", "Hard References"))
+		.SetIcon(FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer"));
+	}
+	TabManager->TryInvokeTab(AssetHardReferenceFinderTabName);
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FHardReferenceFinderModule, HardReferenceFinder)
@@ -0,0 +1,308 @@
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderCookedRegistry.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace HardReferenceCacheInternals
+{
+	static SIZE_T GetAllocatedSize(const FHRFClassAnalysis& Analysis)
+	{
+		return sizeof(Analysis) + Analysis.PropertyReferences.GetAllocatedSize() + Analysis.OverriddenProperties.GetAllocatedSize();
+	}
+
+	static SIZE_T GetAllocatedSize(const FHRFClosureSize& Size)
+	{
+		return sizeof(Size) + Size.SizeByClass.GetAllocatedSize() + Size.SizeByFolder.GetAllocatedSize() + Size.Chunks.GetAllocatedSize();
+	}
+}
+
+TUniquePtr<FHardReferenceFinderCache> FHardReferenceFinderCache::Instance;
+
+void FHardReferenceFinderCache::Initialize()
+{
+	if(!Instance.IsValid())
+	{
+		Instance = MakeUnique<FHardReferenceFinderCache>();
+		Instance->BindInvalidationEvents();
+	}
+}
+
+void FHardReferenceFinderCache::Shutdown()
+{
+	if(Instance.IsValid())
+	{
+		Instance->UnbindInvalidationEvents();
+
+		// The worker building a graph may still be reading the registry
+		if(Instance->PendingDependencyGraphBuild.IsValid())
+		{
+			Instance->PendingDependencyGraphBuild.Wait();
+		}
+		Instance->InvalidateClassAnalysis();
+		Instance->InvalidateClosureSizes();
+		Instance->InvalidateDependencyGraph();
+		Instance->InvalidateCookedRegistries();
+		Instance.Reset();
+	}
+}
+
+FHardReferenceFinderCache& FHardReferenceFinderCache::Get()
+{
+	check(Instance.IsValid());
+	return *Instance;
+}
+
+TSharedRef<const FHRFClassAnalysis> FHardReferenceFinderCache::FindOrAddClassAnalysis(const UClass* Class, TFunctionRef<void(FHRFClassAnalysis&)> Analyze)
+{
+	if(const TSharedRef<const FHRFClassAnalysis>* Existing = ClassAnalyses.Find(Class))
+	{
+		return *Existing;
+	}
+
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Cache);
+	TSharedRef<FHRFClassAnalysis> Analysis = MakeShared<FHRFClassAnalysis>();
+	Analyze(Analysis.Get());
+	ClassAnalyses.Add(Class, Analysis);
+
+	INC_DWORD_STAT(STAT_HRF_NumClassAnalyses);
+	INC_MEMORY_STAT_BY(STAT_HRF_ClassAnalysisMemory, HardReferenceCacheInternals::GetAllocatedSize(Analysis.Get()));
+	return Analysis;
+}
+
+TSharedRef<const FHRFClosureSize> FHardReferenceFinderCache::FindOrAddClosureSize(FName PackageName, FName SizePlatform, TFunctionRef<void(FHRFClosureSize&)> GatherSize)
+{
+	const TPair<FName, FName> Key(PackageName, SizePlatform);
+	if(const TSharedRef<const FHRFClosureSize>* Existing = ClosureSizes.Find(Key))
+	{
+		return *Existing;
+	}
+
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Cache);
+	TSharedRef<FHRFClosureSize> Size = MakeShared<FHRFClosureSize>();
+	GatherSize(Size.Get());
+	ClosureSizes.Add(Key, Size);
+
+	INC_DWORD_STAT(STAT_HRF_NumClosureSizes);
+	INC_MEMORY_STAT_BY(STAT_HRF_ClosureSizeMemory, HardReferenceCacheInternals::GetAllocatedSize(Size.Get()));
+	return Size;
+}
+
+TSharedRef<const FHardReferenceFinderDependencyGraph> FHardReferenceFinderCache::GetDependencyGraph()
+{
+	// A graph already being built is waited for rather than built a second time
+	FinishDependencyGraphBuild();
+	if(!DependencyGraph.IsValid())
+	{
+		SetDependencyGraph(FHardReferenceFinderDependencyGraph::Build(FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"))));
+	}
+	return DependencyGraph.ToSharedRef();
+}
+
+void FHardReferenceFinderCache::GetDependencyGraphAsync(TFunction<void(TSharedRef<const FHardReferenceFinderDependencyGraph>)> OnBuilt)
+{
+	check(IsInGameThread());
+	if(DependencyGraph.IsValid())
+	{
+		OnBuilt(DependencyGraph.ToSharedRef());
+		return;
+	}
+
+	PendingDependencyGraphCallbacks.Add(MoveTemp(OnBuilt));
+	if(PendingDependencyGraphBuild.IsValid())
+	{
+		return;
+	}
+
+	PendingDependencyGraph = MakeShared<FHardReferenceFinderDependencyGraph>();
+	PendingDependencyGraphGeneration = DependencyGraphGeneration;
+	FHardReferenceFinderDependencyGraph* Graph = PendingDependencyGraph.Get();
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	auto OnWorkerFinished = []()
+	{
+		AsyncTask(ENamedThreads::GameThread, []()
+		{
+			if(Instance.IsValid())
+			{
+				Instance->FinishDependencyGraphBuild();
+			}
+		});
+	};
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	// The registry can only be read on the game thread before UE 5.0
+	Graph->CopyFromRegistry(AssetRegistryModule);
+	PendingDependencyGraphBuild = Async(EAsyncExecution::ThreadPool, [Graph]()
+	{
+		Graph->BuildIndices();
+	}, OnWorkerFinished);
+#else
+	PendingDependencyGraphBuild = Async(EAsyncExecution::ThreadPool, [Graph, &AssetRegistryModule]()
+	{
+		Graph->CopyFromRegistry(AssetRegistryModule);
+		Graph->BuildIndices();
+	}, OnWorkerFinished);
+#endif
+}
+
+void FHardReferenceFinderCache::FinishDependencyGraphBuild()
+{
+	if(!PendingDependencyGraphBuild.IsValid())
+	{
+		return;
+	}
+
+	PendingDependencyGraphBuild.Wait();
+	PendingDependencyGraphBuild = TFuture<void>();
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = PendingDependencyGraph.ToSharedRef();
+	PendingDependencyGraph.Reset();
+	if(PendingDependencyGraphGeneration == DependencyGraphGeneration)
+	{
+		SetDependencyGraph(Graph);
+	}
+
+	// Registry changes during the build don't hold up whoever is waiting, the next request builds a fresh graph
+	TArray<TFunction<void(TSharedRef<const FHardReferenceFinderDependencyGraph>)>> Callbacks = MoveTemp(PendingDependencyGraphCallbacks);
+	for(const TFunction<void(TSharedRef<const FHardReferenceFinderDependencyGraph>)>& Callback : Callbacks)
+	{
+		Callback(Graph);
+	}
+}
+
+void FHardReferenceFinderCache::SetDependencyGraph(const TSharedRef<const FHardReferenceFinderDependencyGraph>& Graph)
+{
+	DependencyGraph = Graph;
+	SET_DWORD_STAT(STAT_HRF_NumGraphPackages, Graph->Num());
+	SET_MEMORY_STAT(STAT_HRF_GraphMemory, Graph->GetAllocatedSize());
+}
+
+TSharedPtr<const FHardReferenceFinderCookedRegistry> FHardReferenceFinderCache::FindOrLoadCookedRegistry(FName PlatformName)
+{
+	const FString RegistryFile = FHardReferenceFinderCookedRegistry::FindRegistryFile(PlatformName);
+	if(RegistryFile.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	if(const TSharedRef<const FHardReferenceFinderCookedRegistry>* Existing = CookedRegistries.Find(PlatformName))
+	{
+		if((*Existing)->GetTimeStamp() == IFileManager::Get().GetTimeStamp(*RegistryFile))
+		{
+			return *Existing;
+		}
+	}
+
+	// Closures sized with an older cook of this platform would otherwise mix with the new sizes
+	for(auto It = ClosureSizes.CreateIterator(); It; ++It)
+	{
+		if(It.Key().Value == PlatformName)
+		{
+			DEC_DWORD_STAT(STAT_HRF_NumClosureSizes);
+			DEC_MEMORY_STAT_BY(STAT_HRF_ClosureSizeMemory, HardReferenceCacheInternals::GetAllocatedSize(It.Value().Get()));
+			It.RemoveCurrent();
+		}
+	}
+	if(const TSharedRef<const FHardReferenceFinderCookedRegistry>* Existing = CookedRegistries.Find(PlatformName))
+	{
+		DEC_DWORD_STAT(STAT_HRF_NumCookedRegistries);
+		DEC_MEMORY_STAT_BY(STAT_HRF_CookedRegistryMemory, (*Existing)->GetAllocatedSize());
+		CookedRegistries.Remove(PlatformName);
+	}
+
+	TSharedPtr<FHardReferenceFinderCookedRegistry> Registry = FHardReferenceFinderCookedRegistry::Load(PlatformName);
+	if(Registry.IsValid())
+	{
+		CookedRegistries.Add(PlatformName, Registry.ToSharedRef());
+		INC_DWORD_STAT(STAT_HRF_NumCookedRegistries);
+		INC_MEMORY_STAT_BY(STAT_HRF_CookedRegistryMemory, Registry->GetAllocatedSize());
+	}
+	return Registry;
+}
+
+void FHardReferenceFinderCache::InvalidateClassAnalysis()
+{
+	ClassAnalyses.Reset();
+	SET_DWORD_STAT(STAT_HRF_NumClassAnalyses, 0);
+	SET_MEMORY_STAT(STAT_HRF_ClassAnalysisMemory, 0);
+}
+
+void FHardReferenceFinderCache::InvalidateClosureSizes()
+{
+	ClosureSizes.Reset();
+	SET_DWORD_STAT(STAT_HRF_NumClosureSizes, 0);
+	SET_MEMORY_STAT(STAT_HRF_ClosureSizeMemory, 0);
+}
+
+void FHardReferenceFinderCache::InvalidateDependencyGraph()
+{
+	DependencyGraph.Reset();
+	++DependencyGraphGeneration;
+	SET_DWORD_STAT(STAT_HRF_NumGraphPackages, 0);
+	SET_MEMORY_STAT(STAT_HRF_GraphMemory, 0);
+}
+
+void FHardReferenceFinderCache::InvalidateCookedRegistries()
+{
+	CookedRegistries.Reset();
+	SET_DWORD_STAT(STAT_HRF_NumCookedRegistries, 0);
+	SET_MEMORY_STAT(STAT_HRF_CookedRegistryMemory, 0);
+}
+
+void FHardReferenceFinderCache::BindInvalidationEvents()
+{
+	// Child classes compose the analysis of their parents, so any change in a hierarchy drops every class
+	if(GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FHardReferenceFinderCache::InvalidateClassAnalysis);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FHardReferenceFinderCache::OnObjectPropertyChanged);
+
+	// Closure sizes and the dependency graph depend on the dependencies of every package, so any registry change drops them all
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FHardReferenceFinderCache::OnAssetRegistryChanged);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FHardReferenceFinderCache::OnAssetRegistryChanged);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FHardReferenceFinderCache::OnAssetRegistryChanged);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FHardReferenceFinderCache::OnAssetRegistryRenamed);
+}
+
+void FHardReferenceFinderCache::UnbindInvalidationEvents()
+{
+	if(GEditor)
+	{
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+
+	if(FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+}
+
+void FHardReferenceFinderCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if(Object && Object->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		InvalidateClassAnalysis();
+	}
+}
+
+void FHardReferenceFinderCache::OnAssetRegistryChanged(const FAssetData& AssetData)
+{
+	InvalidateClosureSizes();
+	InvalidateDependencyGraph();
+}
+
+void FHardReferenceFinderCache::OnAssetRegistryRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	InvalidateClosureSizes();
+	InvalidateDependencyGraph();
+}
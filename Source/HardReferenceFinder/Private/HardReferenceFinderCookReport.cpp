@@ -0,0 +1,263 @@
+#include "HardReferenceFinderCookReport.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderCookedRegistry.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "HardReferenceFinderResultsFile.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogHardReferenceCookReport, Log, All);
+
+TUniquePtr<FHardReferenceFinderCookReport> FHardReferenceFinderCookReport::Instance;
+
+namespace HardReferenceCookReportInternals
+{
+	static TAutoConsoleVariable<int32> CVarEnableCookReport(
+		TEXT("HardReferenceFinder.CookReport.Enable"),
+		0,
+		TEXT("Writes the hard references of every cooked blueprint to Saved/HardReferenceFinder/CookReports while cooking. Off by default."));
+
+	static bool IsRunningCook()
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		return IsRunningCommandlet() && FCString::Stristr(FCommandLine::Get(), TEXT("run=cook")) != nullptr;
+#else
+		return IsRunningCookCommandlet();
+#endif
+	}
+}
+
+void FHardReferenceFinderCookReport::Initialize()
+{
+	if(Instance.IsValid() || !IsEnabled())
+	{
+		return;
+	}
+
+	Instance = MakeUnique<FHardReferenceFinderCookReport>();
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	Instance->PackageSavedHandle = UPackage::PackageSavedEvent.AddRaw(Instance.Get(), &FHardReferenceFinderCookReport::OnPackageSaved);
+#else
+	Instance->PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(Instance.Get(), &FHardReferenceFinderCookReport::OnPackageSaved);
+#endif
+
+	// The cooker writes its asset registry at the very end of the cook, cooked sizes can only be read after that
+	Instance->EnginePreExitHandle = FCoreDelegates::OnEnginePreExit.AddRaw(Instance.Get(), &FHardReferenceFinderCookReport::WriteReports);
+	UE_LOG(LogHardReferenceCookReport, Display, TEXT("Hard reference cook report enabled, reports will be written to %s"), *FPaths::GetPath(GetReportPath(NAME_None)));
+}
+
+void FHardReferenceFinderCookReport::Shutdown()
+{
+	Instance.Reset();
+}
+
+bool FHardReferenceFinderCookReport::IsEnabled()
+{
+	using namespace HardReferenceCookReportInternals;
+	return CVarEnableCookReport.GetValueOnGameThread() != 0 && IsRunningCook();
+}
+
+FString FHardReferenceFinderCookReport::GetReportPath(FName PlatformName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HardReferenceFinder"), TEXT("CookReports"), PlatformName.ToString() + TEXT(".hrfaudit"));
+}
+
+FHardReferenceFinderCookReport::FHardReferenceFinderCookReport()
+{
+	SearchData.SetSourcesOnly(true);
+}
+
+FHardReferenceFinderCookReport::~FHardReferenceFinderCookReport()
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	UPackage::PackageSavedEvent.Remove(PackageSavedHandle);
+#else
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+#endif
+	FCoreDelegates::OnEnginePreExit.Remove(EnginePreExitHandle);
+}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+void FHardReferenceFinderCookReport::OnPackageSaved(const FString& PackageFileName, UObject* PackageObject)
+{
+	// The cooker sets PKG_FilterEditorOnly for the duration of a cooked save, saves the cook commandlet makes of
+	// editor packages don't have it. Cooks for targets that keep editor data aren't reported.
+	UPackage* Package = Cast<UPackage>(PackageObject);
+	if(Package && Package->HasAnyPackageFlags(PKG_FilterEditorOnly))
+	{
+		ScanPackage(Package);
+	}
+}
+#else
+void FHardReferenceFinderCookReport::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if(SaveContext.IsCooking())
+	{
+		ScanPackage(Package);
+	}
+}
+#endif
+
+void FHardReferenceFinderCookReport::ScanPackage(UPackage* Package)
+{
+	if(Package == nullptr || ScannedPackages.Contains(Package->GetFName()))
+	{
+		return;
+	}
+	ScannedPackages.Add(Package->GetFName());
+
+	// The cooker has just saved the package, so the blueprint is still loaded and scanning it loads nothing
+	UBlueprint* Blueprint = FindObject<UBlueprint>(Package, *FPackageName::GetShortName(Package));
+	if(Blueprint == nullptr || Blueprint->GeneratedClass == nullptr)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+	SCOPE_CYCLE_COUNTER(STAT_HRF_CookReportScan);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const TArray<FHRFTreeViewItemPtr> Results = SearchData.GatherSearchDataForAsset(Blueprint);
+	Snapshots.Add(FHardReferenceFinderSnapshot::FromSearchResults(Package->GetFName(), Results, 0));
+	INC_DWORD_STAT(STAT_HRF_NumCookReportBlueprints);
+
+	ScanSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void FHardReferenceFinderCookReport::WriteReports()
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+	if(Snapshots.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for(const ITargetPlatform* TargetPlatform : GetTargetPlatformManagerRef().GetActiveTargetPlatforms())
+	{
+		const FName PlatformName(*TargetPlatform->PlatformName());
+		const TSharedPtr<const FHardReferenceFinderCookedRegistry> CookedRegistry = FHardReferenceFinderCache::Get().FindOrLoadCookedRegistry(PlatformName);
+		if(!CookedRegistry.IsValid())
+		{
+			UE_LOG(LogHardReferenceCookReport, Warning, TEXT("No cooked asset registry was found for %s, its hard reference report was not written"), *PlatformName.ToString());
+			continue;
+		}
+
+		const TMap<FName, int64> ClosureSizes = GatherCookedClosureSizes(*CookedRegistry);
+		FHardReferenceFinderResultsWriter Writer;
+		for(const FHardReferenceFinderSnapshot& Snapshot : Snapshots)
+		{
+			TArray<FHRFSnapshotPackage> Packages = Snapshot.GetPackages();
+			for(FHRFSnapshotPackage& Package : Packages)
+			{
+				Package.SizeOnDisk = ClosureSizes.FindRef(Package.PackageId);
+			}
+			Writer.AddBlueprint(FHardReferenceFinderSnapshot(Snapshot.GetBlueprintPackage(), MoveTemp(Packages), ClosureSizes.FindRef(Snapshot.GetBlueprintPackage())));
+		}
+
+		const FString ReportPath = GetReportPath(PlatformName);
+		if(Writer.SaveToFile(ReportPath))
+		{
+			UE_LOG(LogHardReferenceCookReport, Display, TEXT("Wrote the hard references of %d blueprints to %s"), Writer.GetNumBlueprints(), *ReportPath);
+		}
+		else
+		{
+			UE_LOG(LogHardReferenceCookReport, Error, TEXT("Failed to write %s"), *ReportPath);
+		}
+	}
+	ReportSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Measured against the lifetime of the process, which is the cook plus engine startup
+	const double CookSeconds = FMath::Max(FPlatformTime::Seconds() - GStartTime, 1.0);
+	const double HookSeconds = ScanSeconds + ReportSeconds;
+	UE_LOG(LogHardReferenceCookReport, Display, TEXT("Hard reference cook report took %.2fs (%.2fs scanning %d blueprints, %.2fs sizing and writing), %.2f%% of the %.0fs cook"),
+		HookSeconds, ScanSeconds, Snapshots.Num(), ReportSeconds, 100.0 * HookSeconds / CookSeconds, CookSeconds);
+
+	// Written once, the cook is over
+	Snapshots.Empty();
+	ScannedPackages.Empty();
+	SET_DWORD_STAT(STAT_HRF_NumCookReportBlueprints, 0);
+}
+
+TMap<FName, int64> FHardReferenceFinderCookReport::GatherCookedClosureSizes(const FHardReferenceFinderCookedRegistry& CookedRegistry) const
+{
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	const int32 NumComponents = Graph->NumComponents();
+
+	// Cooked sizes are summed per strongly connected component once, closures then only add up component sizes
+	TArray<int64> ComponentSizes;
+	ComponentSizes.SetNumZeroed(NumComponents);
+	for(int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		for(const int32 Package : Graph->GetComponentPackages(Component))
+		{
+			ComponentSizes[Component] += CookedRegistry.GetCookedSize(Graph->GetPackageName(Package));
+		}
+	}
+
+	// Blueprints share most of their headers, and packages in one component share their closure, so each
+	// component referenced by any blueprint, or holding one, is walked once
+	TMap<FName, int32> PackageComponents;
+	TArray<int32> Components;
+	TMap<int32, int32> ComponentToClosure;
+	const auto AddPackage = [&Graph, &PackageComponents, &Components, &ComponentToClosure](FName PackageId)
+	{
+		if(PackageComponents.Contains(PackageId))
+		{
+			return;
+		}
+
+		const int32 GraphIndex = Graph->FindPackage(PackageId);
+		if(GraphIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		const int32 Component = Graph->GetComponent(GraphIndex);
+		PackageComponents.Add(PackageId, Component);
+		if(!ComponentToClosure.Contains(Component))
+		{
+			ComponentToClosure.Add(Component, Components.Add(Component));
+		}
+	};
+	for(const FHardReferenceFinderSnapshot& Snapshot : Snapshots)
+	{
+		AddPackage(Snapshot.GetBlueprintPackage());
+		for(const FHRFSnapshotPackage& Package : Snapshot.GetPackages())
+		{
+			AddPackage(Package.PackageId);
+		}
+	}
+
+	TArray<int64> ClosureSizes;
+	ClosureSizes.SetNumZeroed(Components.Num());
+	ParallelFor(Components.Num(), [&Graph, &Components, &ComponentSizes, &ClosureSizes, NumComponents](int32 ClosureIndex)
+	{
+		LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+		TBitArray<> Closure(false, NumComponents);
+		Graph->GatherClosureComponents(Graph->GetComponentPackages(Components[ClosureIndex])[0], Closure);
+		for(TConstSetBitIterator<> It(Closure); It; ++It)
+		{
+			ClosureSizes[ClosureIndex] += ComponentSizes[It.GetIndex()];
+		}
+	});
+
+	TMap<FName, int64> PackageClosureSizes;
+	PackageClosureSizes.Reserve(PackageComponents.Num());
+	for(const TPair<FName, int32>& PackageComponent : PackageComponents)
+	{
+		PackageClosureSizes.Add(PackageComponent.Key, ClosureSizes[ComponentToClosure[PackageComponent.Value]]);
+	}
+	return PackageClosureSizes;
+}
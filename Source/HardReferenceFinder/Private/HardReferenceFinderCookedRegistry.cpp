@@ -0,0 +1,144 @@
+#include "HardReferenceFinderCookedRegistry.h"
+#include "HardReferenceFinderMemory.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/Paths.h"
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "AssetRegistryState.h"
+#else
+#include "AssetRegistry/AssetRegistryState.h"
+#endif
+
+namespace HardReferenceCookedInternals
+{
+	static FString GetCookedDir()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Cooked"));
+	}
+
+	static FString GetCookedProjectDir(FName PlatformName)
+	{
+		return FPaths::Combine(GetCookedDir(), PlatformName.ToString(), FApp::GetProjectName());
+	}
+}
+
+TArray<FName> FHardReferenceFinderCookedRegistry::FindCookedPlatforms()
+{
+	TArray<FString> PlatformDirs;
+	IFileManager::Get().FindFiles(PlatformDirs, *FPaths::Combine(HardReferenceCookedInternals::GetCookedDir(), TEXT("*")), false, true);
+	PlatformDirs.Sort();
+
+	TArray<FName> Platforms;
+	for(const FString& PlatformDir : PlatformDirs)
+	{
+		const FName PlatformName(*PlatformDir);
+		if(!FindRegistryFile(PlatformName).IsEmpty())
+		{
+			Platforms.Add(PlatformName);
+		}
+	}
+	return Platforms;
+}
+
+FString FHardReferenceFinderCookedRegistry::FindRegistryFile(FName PlatformName)
+{
+	const FString ProjectDir = HardReferenceCookedInternals::GetCookedProjectDir(PlatformName);
+	const FString Candidates[] = {
+		FPaths::Combine(ProjectDir, TEXT("Metadata"), TEXT("DevelopmentAssetRegistry.bin")),
+		FPaths::Combine(ProjectDir, TEXT("AssetRegistry.bin")),
+	};
+	for(const FString& Candidate : Candidates)
+	{
+		if(FPaths::FileExists(Candidate))
+		{
+			return Candidate;
+		}
+	}
+	return FString();
+}
+
+TSharedPtr<FHardReferenceFinderCookedRegistry> FHardReferenceFinderCookedRegistry::Load(FName PlatformName)
+{
+	const FString RegistryFile = FindRegistryFile(PlatformName);
+	if(RegistryFile.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Cache);
+	FAssetRegistryState State;
+	if(!FAssetRegistryState::LoadFromDisk(*RegistryFile, FAssetRegistryLoadOptions(), State))
+	{
+		return nullptr;
+	}
+
+	// Only sizes and chunks are kept, the state itself holds every asset's tags and is far larger than this index
+	TSharedRef<FHardReferenceFinderCookedRegistry> Registry = MakeShared<FHardReferenceFinderCookedRegistry>();
+	Registry->PlatformName = PlatformName;
+	Registry->TimeStamp = IFileManager::Get().GetTimeStamp(*RegistryFile);
+	Registry->CookedPackages.Reserve(State.GetAssetPackageDataMap().Num());
+
+	TMap<int32, int32> ChunkIdToIndex;
+	for(const auto& PackageData : State.GetAssetPackageDataMap())
+	{
+		FCookedPackage& CookedPackage = Registry->CookedPackages.Add(PackageData.Key);
+		CookedPackage.CookedSize = FMath::Max<int64>(PackageData.Value->DiskSize, 0);
+
+		for(const FAssetData* AssetData : State.GetAssetsByPackageName(PackageData.Key))
+		{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+			for(const int32 ChunkId : AssetData->ChunkIDs)
+#else
+			for(const int32 ChunkId : AssetData->GetChunkIDs())
+#endif
+			{
+				int32* ChunkIndex = ChunkIdToIndex.Find(ChunkId);
+				if(ChunkIndex == nullptr)
+				{
+					ChunkIndex = &ChunkIdToIndex.Add(ChunkId, Registry->ChunkIds.Add(ChunkId));
+				}
+				CookedPackage.Chunks.Add(*ChunkIndex);
+			}
+		}
+	}
+	return Registry;
+}
+
+int64 FHardReferenceFinderCookedRegistry::GetCookedSize(FName PackageName) const
+{
+	const FCookedPackage* CookedPackage = CookedPackages.Find(PackageName);
+	return CookedPackage ? CookedPackage->CookedSize : 0;
+}
+
+const FHRFChunkSet* FHardReferenceFinderCookedRegistry::FindChunks(FName PackageName) const
+{
+	const FCookedPackage* CookedPackage = CookedPackages.Find(PackageName);
+	return CookedPackage ? &CookedPackage->Chunks : nullptr;
+}
+
+FString FHardReferenceFinderCookedRegistry::MakeChunkListString(const FHRFChunkSet& Chunks) const
+{
+	TArray<int32> SortedChunkIds;
+	Chunks.ForEach([this, &SortedChunkIds](int32 ChunkIndex)
+	{
+		SortedChunkIds.Add(ChunkIds[ChunkIndex]);
+	});
+	SortedChunkIds.Sort();
+
+	return FString::JoinBy(SortedChunkIds, TEXT(", "), [](int32 ChunkId)
+	{
+		return FString::FromInt(ChunkId);
+	});
+}
+
+SIZE_T FHardReferenceFinderCookedRegistry::GetAllocatedSize() const
+{
+	SIZE_T Size = sizeof(*this) + CookedPackages.GetAllocatedSize() + ChunkIds.GetAllocatedSize();
+	for(const TPair<FName, FCookedPackage>& CookedPackage : CookedPackages)
+	{
+		Size += CookedPackage.Value.Chunks.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,525 @@
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/EngineVersionComparison.h"
+
+namespace HardReferenceGraphInternals
+{
+	static int64 GetPackageDiskSize(FName PackageName, FAssetRegistryModule& AssetRegistryModule)
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		if(const FAssetPackageData* AssetPackageData = AssetRegistryModule.Get().GetAssetPackageData(PackageName))
+		{
+			return AssetPackageData->DiskSize;
+		}
+#elif UE_VERSION_OLDER_THAN(5, 1, 0)
+		const TOptional<FAssetPackageData> AssetPackageData = AssetRegistryModule.Get().GetAssetPackageDataCopy(PackageName);
+		if(AssetPackageData.IsSet())
+		{
+			return AssetPackageData.GetValue().DiskSize;
+		}
+#else
+		FAssetPackageData AssetPackageData;
+		if(AssetRegistryModule.TryGetAssetPackageData(PackageName, AssetPackageData) == UE::AssetRegistry::EExists::Exists)
+		{
+			return AssetPackageData.DiskSize;
+		}
+#endif
+		return 0;
+	}
+}
+
+TSharedRef<FHardReferenceFinderDependencyGraph> FHardReferenceFinderDependencyGraph::Build(FAssetRegistryModule& AssetRegistryModule)
+{
+	const TSharedRef<FHardReferenceFinderDependencyGraph> Graph = MakeShared<FHardReferenceFinderDependencyGraph>();
+	Graph->CopyFromRegistry(AssetRegistryModule);
+	Graph->BuildIndices();
+	return Graph;
+}
+
+void FHardReferenceFinderDependencyGraph::CopyFromRegistry(FAssetRegistryModule& AssetRegistryModule)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+	check(PackageNames.Num() == 0);
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	TArray<FAssetData> AllAssets;
+	AssetRegistry.GetAllAssets(AllAssets, true);
+	PackageNames.Reserve(AllAssets.Num());
+	for(const FAssetData& AssetData : AllAssets)
+	{
+		FindOrAddPackage(AssetData.PackageName);
+	}
+
+	// Dependencies may add packages without assets, e.g. script packages, so the list can grow while it's walked
+	const UE::AssetRegistry::FDependencyQuery Flags(UE::AssetRegistry::EDependencyQuery::Hard);
+	TArray<FName> PackageDependencies;
+	for(int32 Package = 0; Package < PackageNames.Num(); ++Package)
+	{
+		DependencyOffsets.Add(Dependencies.Num());
+
+		PackageDependencies.Reset();
+		AssetRegistry.GetDependencies(PackageNames[Package], PackageDependencies, UE::AssetRegistry::EDependencyCategory::Package, Flags);
+		for(const FName& Dependency : PackageDependencies)
+		{
+			Dependencies.Add(FindOrAddPackage(Dependency));
+		}
+	}
+	DependencyOffsets.Add(Dependencies.Num());
+
+	for(int32 Package = 0; Package < PackageNames.Num(); ++Package)
+	{
+		DiskSizes[Package] = HardReferenceGraphInternals::GetPackageDiskSize(PackageNames[Package], AssetRegistryModule);
+	}
+}
+
+void FHardReferenceFinderDependencyGraph::BuildIndices()
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+	BuildReferencers();
+	BuildComponents();
+}
+
+TSharedRef<FHardReferenceFinderDependencyGraph> FHardReferenceFinderDependencyGraph::BuildFromEdges(TArrayView<const FName> InPackageNames, TArrayView<const int64> InDiskSizes, TArrayView<const TPair<int32, int32>> Edges)
+{
+	check(InPackageNames.Num() == InDiskSizes.Num());
+	TSharedRef<FHardReferenceFinderDependencyGraph> Graph = MakeShared<FHardReferenceFinderDependencyGraph>();
+	for(int32 Package = 0; Package < InPackageNames.Num(); ++Package)
+	{
+		verify(Graph->FindOrAddPackage(InPackageNames[Package]) == Package);
+		Graph->DiskSizes[Package] = InDiskSizes[Package];
+	}
+
+	// Edges are grouped by referencer to lay them out like the registry graph
+	TArray<TPair<int32, int32>> SortedEdges(Edges.GetData(), Edges.Num());
+	SortedEdges.StableSort([](const TPair<int32, int32>& Lhs, const TPair<int32, int32>& Rhs)
+	{
+		return Lhs.Key < Rhs.Key;
+	});
+
+	int32 EdgeIndex = 0;
+	for(int32 Package = 0; Package < Graph->PackageNames.Num(); ++Package)
+	{
+		Graph->DependencyOffsets.Add(Graph->Dependencies.Num());
+		for(; EdgeIndex < SortedEdges.Num() && SortedEdges[EdgeIndex].Key == Package; ++EdgeIndex)
+		{
+			Graph->Dependencies.Add(SortedEdges[EdgeIndex].Value);
+		}
+	}
+	Graph->DependencyOffsets.Add(Graph->Dependencies.Num());
+
+	Graph->BuildIndices();
+	return Graph;
+}
+
+int32 FHardReferenceFinderDependencyGraph::FindPackage(FName PackageName) const
+{
+	const int32* Package = PackageToIndex.Find(PackageName);
+	return Package ? *Package : INDEX_NONE;
+}
+
+TArrayView<const int32> FHardReferenceFinderDependencyGraph::GetDependencies(int32 Package) const
+{
+	const int32 First = DependencyOffsets[Package];
+	return TArrayView<const int32>(Dependencies.GetData() + First, DependencyOffsets[Package + 1] - First);
+}
+
+TArrayView<const int32> FHardReferenceFinderDependencyGraph::GetReferencers(int32 Package) const
+{
+	const int32 First = ReferencerOffsets[Package];
+	return TArrayView<const int32>(Referencers.GetData() + First, ReferencerOffsets[Package + 1] - First);
+}
+
+TArrayView<const int32> FHardReferenceFinderDependencyGraph::GetComponentPackages(int32 Component) const
+{
+	const int32 First = ComponentPackageOffsets[Component];
+	return TArrayView<const int32>(ComponentPackages.GetData() + First, ComponentPackageOffsets[Component + 1] - First);
+}
+
+int64 FHardReferenceFinderDependencyGraph::GetClosureSize(int32 Package) const
+{
+	// Walks the condensed graph, every component is visited once no matter how many paths lead to it
+	TBitArray<> Visited(false, ComponentSizes.Num());
+	TArray<int32> Frontier;
+	Frontier.Add(ComponentOf[Package]);
+	Visited[ComponentOf[Package]] = true;
+
+	int64 Size = 0;
+	while(Frontier.Num() > 0)
+	{
+		const int32 Component = Frontier.Pop(false);
+		Size += ComponentSizes[Component];
+
+		for(int32 Edge = ComponentDependencyOffsets[Component]; Edge < ComponentDependencyOffsets[Component + 1]; ++Edge)
+		{
+			const int32 Dependency = ComponentDependencies[Edge];
+			if(!Visited[Dependency])
+			{
+				Visited[Dependency] = true;
+				Frontier.Add(Dependency);
+			}
+		}
+	}
+	return Size;
+}
+
+void FHardReferenceFinderDependencyGraph::GatherClosureComponents(int32 Package, TBitArray<>& OutComponents) const
+{
+	check(OutComponents.Num() == ComponentSizes.Num());
+	TArray<int32> Frontier;
+	Frontier.Add(ComponentOf[Package]);
+	OutComponents[ComponentOf[Package]] = true;
+
+	while(Frontier.Num() > 0)
+	{
+		const int32 Component = Frontier.Pop(false);
+		for(int32 Edge = ComponentDependencyOffsets[Component]; Edge < ComponentDependencyOffsets[Component + 1]; ++Edge)
+		{
+			const int32 Dependency = ComponentDependencies[Edge];
+			if(!OutComponents[Dependency])
+			{
+				OutComponents[Dependency] = true;
+				Frontier.Add(Dependency);
+			}
+		}
+	}
+}
+
+SIZE_T FHardReferenceFinderDependencyGraph::GetAllocatedSize() const
+{
+	return sizeof(*this) + PackageNames.GetAllocatedSize() + PackageToIndex.GetAllocatedSize() + DiskSizes.GetAllocatedSize()
+		+ DependencyOffsets.GetAllocatedSize() + Dependencies.GetAllocatedSize()
+		+ ReferencerOffsets.GetAllocatedSize() + Referencers.GetAllocatedSize()
+		+ ComponentOf.GetAllocatedSize() + ComponentSizes.GetAllocatedSize()
+		+ ComponentDependencyOffsets.GetAllocatedSize() + ComponentDependencies.GetAllocatedSize()
+		+ ComponentPackageOffsets.GetAllocatedSize() + ComponentPackages.GetAllocatedSize();
+}
+
+int32 FHardReferenceFinderDependencyGraph::FindOrAddPackage(FName PackageName)
+{
+	if(const int32* Existing = PackageToIndex.Find(PackageName))
+	{
+		return *Existing;
+	}
+
+	const int32 Package = PackageNames.Add(PackageName);
+	DiskSizes.Add(0);
+	PackageToIndex.Add(PackageName, Package);
+	return Package;
+}
+
+TArray<TArray<int32>> FHardReferenceFinderDependencyGraph::FindShortestPaths(int32 FromPackage, int32 ToPackage, int32 MaxPaths) const
+{
+	// Yen's algorithm: every further path branches off one of the paths already found, at each branch point the
+	// edges taken by earlier paths are blocked and the shortest remaining route to the target is searched for.
+	TArray<TArray<int32>> Paths;
+	TArray<TArray<int32>> Candidates;
+
+	TArray<int32> ShortestPath;
+	if(!FindShortestPath(ShortestPath, FromPackage, ToPackage, TSet<int32>(), TSet<TPair<int32, int32>>()))
+	{
+		return Paths;
+	}
+	Paths.Add(MoveTemp(ShortestPath));
+
+	while(Paths.Num() < MaxPaths)
+	{
+		const TArray<int32>& PreviousPath = Paths.Last();
+		for(int32 BranchIndex = 0; BranchIndex < PreviousPath.Num() - 1; ++BranchIndex)
+		{
+			TSet<TPair<int32, int32>> BlockedEdges;
+			for(const TArray<int32>& Path : Paths)
+			{
+				const bool bSharesRoot = Path.Num() > BranchIndex + 1 && FMemory::Memcmp(Path.GetData(), PreviousPath.GetData(), (BranchIndex + 1) * sizeof(int32)) == 0;
+				if(bSharesRoot)
+				{
+					BlockedEdges.Add(TPair<int32, int32>(Path[BranchIndex], Path[BranchIndex + 1]));
+				}
+			}
+
+			// Paths stay simple by not revisiting the packages before the branch point
+			TSet<int32> BlockedPackages;
+			for(int32 RootIndex = 0; RootIndex < BranchIndex; ++RootIndex)
+			{
+				BlockedPackages.Add(PreviousPath[RootIndex]);
+			}
+
+			TArray<int32> BranchPath;
+			if(FindShortestPath(BranchPath, PreviousPath[BranchIndex], ToPackage, BlockedPackages, BlockedEdges))
+			{
+				TArray<int32> Candidate(PreviousPath.GetData(), BranchIndex);
+				Candidate.Append(BranchPath);
+				if(!Candidates.Contains(Candidate) && !Paths.Contains(Candidate))
+				{
+					Candidates.Add(MoveTemp(Candidate));
+				}
+			}
+		}
+
+		if(Candidates.Num() == 0)
+		{
+			break;
+		}
+
+		int32 ShortestCandidate = 0;
+		for(int32 CandidateIndex = 1; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+		{
+			if(Candidates[CandidateIndex].Num() < Candidates[ShortestCandidate].Num())
+			{
+				ShortestCandidate = CandidateIndex;
+			}
+		}
+		Paths.Add(MoveTemp(Candidates[ShortestCandidate]));
+		Candidates.RemoveAtSwap(ShortestCandidate);
+	}
+
+	return Paths;
+}
+
+bool FHardReferenceFinderDependencyGraph::FindShortestPath(TArray<int32>& OutPath, int32 FromPackage, int32 ToPackage, const TSet<int32>& BlockedPackages, const TSet<TPair<int32, int32>>& BlockedEdges) const
+{
+	OutPath.Reset();
+	if(FromPackage == ToPackage)
+	{
+		OutPath.Add(FromPackage);
+		return true;
+	}
+
+	// Bidirectional breadth first search, one side follows dependencies from the source and the other follows
+	// referencers from the target. The smaller frontier is expanded a whole level at a time, so the two searches meet
+	// after visiting a tiny fraction of a large closure. Parents are stored per side to rebuild the path.
+	TMap<int32, int32> ForwardParents;
+	TMap<int32, int32> BackwardParents;
+	ForwardParents.Add(FromPackage, INDEX_NONE);
+	BackwardParents.Add(ToPackage, INDEX_NONE);
+	TArray<int32> ForwardFrontier = { FromPackage };
+	TArray<int32> BackwardFrontier = { ToPackage };
+	TArray<int32> NextFrontier;
+	TArray<int32> Meetings;
+
+	while(Meetings.Num() == 0 && ForwardFrontier.Num() > 0 && BackwardFrontier.Num() > 0)
+	{
+		const bool bExpandForward = ForwardFrontier.Num() <= BackwardFrontier.Num();
+		TArray<int32>& Frontier = bExpandForward ? ForwardFrontier : BackwardFrontier;
+		TMap<int32, int32>& Parents = bExpandForward ? ForwardParents : BackwardParents;
+		const TMap<int32, int32>& OtherParents = bExpandForward ? BackwardParents : ForwardParents;
+
+		NextFrontier.Reset();
+		for(const int32 Package : Frontier)
+		{
+			for(const int32 Neighbor : bExpandForward ? GetDependencies(Package) : GetReferencers(Package))
+			{
+				const TPair<int32, int32> Edge = bExpandForward ? TPair<int32, int32>(Package, Neighbor) : TPair<int32, int32>(Neighbor, Package);
+				if(Parents.Contains(Neighbor) || BlockedPackages.Contains(Neighbor) || BlockedEdges.Contains(Edge))
+				{
+					continue;
+				}
+
+				Parents.Add(Neighbor, Package);
+				NextFrontier.Add(Neighbor);
+				if(OtherParents.Contains(Neighbor))
+				{
+					Meetings.Add(Neighbor);
+				}
+			}
+		}
+		Swap(Frontier, NextFrontier);
+	}
+
+	if(Meetings.Num() == 0)
+	{
+		return false;
+	}
+
+	// Every meeting found in the last level is equally far from this side, take the one closest to the other side
+	const auto GetDepth = [](const TMap<int32, int32>& Parents, int32 Package)
+	{
+		int32 Depth = 0;
+		for(Package = Parents[Package]; Package != INDEX_NONE; Package = Parents[Package])
+		{
+			++Depth;
+		}
+		return Depth;
+	};
+	int32 MeetingPackage = Meetings[0];
+	int32 MeetingDepth = GetDepth(ForwardParents, MeetingPackage) + GetDepth(BackwardParents, MeetingPackage);
+	for(const int32 Meeting : Meetings)
+	{
+		const int32 Depth = GetDepth(ForwardParents, Meeting) + GetDepth(BackwardParents, Meeting);
+		if(Depth < MeetingDepth)
+		{
+			MeetingPackage = Meeting;
+			MeetingDepth = Depth;
+		}
+	}
+
+	for(int32 Package = MeetingPackage; Package != INDEX_NONE; Package = ForwardParents[Package])
+	{
+		OutPath.Insert(Package, 0);
+	}
+	for(int32 Package = BackwardParents[MeetingPackage]; Package != INDEX_NONE; Package = BackwardParents[Package])
+	{
+		OutPath.Add(Package);
+	}
+	return true;
+}
+
+void FHardReferenceFinderDependencyGraph::BuildReferencers()
+{
+	const int32 NumPackages = PackageNames.Num();
+	TArray<int32> NumReferencers;
+	NumReferencers.Init(0, NumPackages);
+	for(const int32 Dependency : Dependencies)
+	{
+		++NumReferencers[Dependency];
+	}
+
+	ReferencerOffsets.SetNumUninitialized(NumPackages + 1);
+	ReferencerOffsets[0] = 0;
+	for(int32 Package = 0; Package < NumPackages; ++Package)
+	{
+		ReferencerOffsets[Package + 1] = ReferencerOffsets[Package] + NumReferencers[Package];
+	}
+
+	// Reuse the counts as the write cursor of each package
+	Referencers.SetNumUninitialized(Dependencies.Num());
+	for(int32 Package = 0; Package < NumPackages; ++Package)
+	{
+		NumReferencers[Package] = ReferencerOffsets[Package];
+	}
+	for(int32 Package = 0; Package < NumPackages; ++Package)
+	{
+		for(const int32 Dependency : GetDependencies(Package))
+		{
+			Referencers[NumReferencers[Dependency]++] = Package;
+		}
+	}
+}
+
+void FHardReferenceFinderDependencyGraph::BuildComponents()
+{
+	// Iterative Tarjan, the dependency chains of large projects are far too deep to recurse through
+	const int32 NumPackages = PackageNames.Num();
+	TArray<int32> VisitIndex;
+	VisitIndex.Init(INDEX_NONE, NumPackages);
+	TArray<int32> LowLink;
+	LowLink.Init(INDEX_NONE, NumPackages);
+	TBitArray<> OnStack(false, NumPackages);
+	TArray<int32> Stack;
+	ComponentOf.Init(INDEX_NONE, NumPackages);
+	ComponentSizes.Reset();
+
+	struct FVisit
+	{
+		int32 Package;
+		int32 NextEdge;
+	};
+	TArray<FVisit> Visits;
+	int32 NextVisitIndex = 0;
+
+	for(int32 Root = 0; Root < NumPackages; ++Root)
+	{
+		if(VisitIndex[Root] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		VisitIndex[Root] = LowLink[Root] = NextVisitIndex++;
+		Stack.Add(Root);
+		OnStack[Root] = true;
+		Visits.Add({Root, DependencyOffsets[Root]});
+
+		while(Visits.Num() > 0)
+		{
+			const int32 Package = Visits.Last().Package;
+			if(Visits.Last().NextEdge < DependencyOffsets[Package + 1])
+			{
+				const int32 Dependency = Dependencies[Visits.Last().NextEdge++];
+				if(VisitIndex[Dependency] == INDEX_NONE)
+				{
+					VisitIndex[Dependency] = LowLink[Dependency] = NextVisitIndex++;
+					Stack.Add(Dependency);
+					OnStack[Dependency] = true;
+					Visits.Add({Dependency, DependencyOffsets[Dependency]});
+				}
+				else if(OnStack[Dependency])
+				{
+					LowLink[Package] = FMath::Min(LowLink[Package], VisitIndex[Dependency]);
+				}
+				continue;
+			}
+
+			// Every dependency has been visited, a package that is its own root closes a component
+			if(LowLink[Package] == VisitIndex[Package])
+			{
+				const int32 Component = ComponentSizes.Add(0);
+				int32 Member = INDEX_NONE;
+				do
+				{
+					Member = Stack.Pop(false);
+					OnStack[Member] = false;
+					ComponentOf[Member] = Component;
+					ComponentSizes[Component] += DiskSizes[Member];
+				}
+				while(Member != Package);
+			}
+
+			Visits.Pop(false);
+			if(Visits.Num() > 0)
+			{
+				const int32 Parent = Visits.Last().Package;
+				LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[Package]);
+			}
+		}
+	}
+
+	// Edges between components, with duplicates from packages that were merged removed
+	TArray<TPair<int32, int32>> ComponentEdges;
+	for(int32 Package = 0; Package < NumPackages; ++Package)
+	{
+		for(const int32 Dependency : GetDependencies(Package))
+		{
+			if(ComponentOf[Package] != ComponentOf[Dependency])
+			{
+				ComponentEdges.Emplace(ComponentOf[Package], ComponentOf[Dependency]);
+			}
+		}
+	}
+	ComponentEdges.Sort([](const TPair<int32, int32>& Lhs, const TPair<int32, int32>& Rhs)
+	{
+		return Lhs.Key != Rhs.Key ? Lhs.Key < Rhs.Key : Lhs.Value < Rhs.Value;
+	});
+
+	ComponentDependencyOffsets.Reset(ComponentSizes.Num() + 1);
+	ComponentDependencies.Reset(ComponentEdges.Num());
+	int32 EdgeIndex = 0;
+	for(int32 Component = 0; Component < ComponentSizes.Num(); ++Component)
+	{
+		ComponentDependencyOffsets.Add(ComponentDependencies.Num());
+		for(; EdgeIndex < ComponentEdges.Num() && ComponentEdges[EdgeIndex].Key == Component; ++EdgeIndex)
+		{
+			if(ComponentDependencies.Num() == ComponentDependencyOffsets.Last() || ComponentDependencies.Last() != ComponentEdges[EdgeIndex].Value)
+			{
+				ComponentDependencies.Add(ComponentEdges[EdgeIndex].Value);
+			}
+		}
+	}
+	ComponentDependencyOffsets.Add(ComponentDependencies.Num());
+
+	// Members of each component, so a closure can list its packages without scanning every package in the graph
+	ComponentPackageOffsets.Init(0, ComponentSizes.Num() + 1);
+	for(int32 Package = 0; Package < NumPackages; ++Package)
+	{
+		++ComponentPackageOffsets[ComponentOf[Package] + 1];
+	}
+	for(int32 Component = 0; Component < ComponentSizes.Num(); ++Component)
+	{
+		ComponentPackageOffsets[Component + 1] += ComponentPackageOffsets[Component];
+	}
+	ComponentPackages.SetNumUninitialized(NumPackages);
+	TArray<int32> NextSlot(ComponentPackageOffsets.GetData(), ComponentSizes.Num());
+	for(int32 Package = 0; Package < NumPackages; ++Package)
+	{
+		ComponentPackages[NextSlot[ComponentOf[Package]]++] = Package;
+	}
+}
@@ -0,0 +1,275 @@
+#include "HardReferenceFinderFilter.h"
+#include "HardReferenceFinderMemory.h"
+#include "Algo/BinarySearch.h"
+
+void FHardReferenceFinderFilter::Reset()
+{
+	bIsBuilt = false;
+	Tokens.Reset();
+	TokenResults.Reset();
+	NumResults = 0;
+	LastTerms.Reset();
+	LastMatches.Reset();
+	bHasLastMatches = false;
+}
+
+TArray<FHRFTreeViewItemPtr> FHardReferenceFinderFilter::Apply(const TArray<FHRFTreeViewItemPtr>& Results, const FString& Query)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	if(!bIsBuilt)
+	{
+		Build(Results);
+	}
+
+	TArray<FTerm> Terms;
+	ParseQuery(Query, Terms);
+
+	// Typing usually narrows the query down, then only what matched last time needs to be checked again
+	TArray<int32> Matches;
+	if(bHasLastMatches && IsNarrowing(LastTerms, Terms))
+	{
+		Matches = MoveTemp(LastMatches);
+	}
+	else
+	{
+		Matches.Reserve(NumResults);
+		for(int32 ResultIndex = 0; ResultIndex < NumResults; ++ResultIndex)
+		{
+			Matches.Add(ResultIndex);
+		}
+	}
+
+	TBitArray<> WordMatches;
+	TBitArray<> ExcludedMatches;
+	for(const FTerm& Term : Terms)
+	{
+		if(Matches.Num() == 0)
+		{
+			break;
+		}
+
+		if(!Term.bIsNegated)
+		{
+			for(const FString& Word : Term.Words)
+			{
+				MarkMatchingResults(Word, Term.bIsQuoted, WordMatches);
+				Matches.RemoveAll([&WordMatches](int32 ResultIndex)
+				{
+					return !WordMatches[ResultIndex];
+				});
+			}
+			continue;
+		}
+
+		// Only results matching every word of a negated term are excluded
+		ExcludedMatches.Init(true, NumResults);
+		for(const FString& Word : Term.Words)
+		{
+			MarkMatchingResults(Word, Term.bIsQuoted, WordMatches);
+			for(const int32 ResultIndex : Matches)
+			{
+				ExcludedMatches[ResultIndex] = ExcludedMatches[ResultIndex] && WordMatches[ResultIndex];
+			}
+		}
+		Matches.RemoveAll([&ExcludedMatches](int32 ResultIndex)
+		{
+			return ExcludedMatches[ResultIndex];
+		});
+	}
+
+	LastTerms = MoveTemp(Terms);
+	LastMatches = Matches;
+	bHasLastMatches = true;
+
+	TArray<FHRFTreeViewItemPtr> FilteredResults;
+	int32 NextMatch = 0;
+	for(int32 ResultIndex = 0; ResultIndex < Results.Num(); ++ResultIndex)
+	{
+		const bool bIsMatch = NextMatch < Matches.Num() && Matches[NextMatch] == ResultIndex;
+		NextMatch += bIsMatch ? 1 : 0;
+		if(bIsMatch || Results[ResultIndex]->PackageId.IsNone())
+		{
+			FilteredResults.Add(Results[ResultIndex]);
+		}
+	}
+	return FilteredResults;
+}
+
+void FHardReferenceFinderFilter::Build(const TArray<FHRFTreeViewItemPtr>& Results)
+{
+	Reset();
+	NumResults = Results.Num();
+
+	TMap<FString, TArray<int32>> TokenMap;
+	for(int32 ResultIndex = 0; ResultIndex < Results.Num(); ++ResultIndex)
+	{
+		const FHRFTreeViewItemPtr& Result = Results[ResultIndex];
+		TArray<FString> Texts;
+		Texts.Add(Result->PackageId.ToString());
+		Texts.Add(Result->AssetClass.ToString());
+		Texts.Add(Result->Name.ToString());
+
+		// Source names are normally looked up when a row is shown, searching them needs them all
+		for(const FHRFTreeViewItemPtr& Child : Result->Children)
+		{
+			Child->ResolveDisplayInfo();
+			Texts.Add(Child->Name.ToString());
+		}
+
+		for(const FString& Text : Texts)
+		{
+			TArray<FString> Words;
+			SplitWords(Text, Words);
+			for(const FString& Word : Words)
+			{
+				// Each case change starts another token, "HeroCharacter" gives "herocharacter" and "character"
+				for(int32 Start = 0; Start < Word.Len(); ++Start)
+				{
+					const bool bStartsToken = Start == 0
+						|| (FChar::IsUpper(Word[Start]) && !FChar::IsUpper(Word[Start - 1]))
+						|| (FChar::IsDigit(Word[Start]) != FChar::IsDigit(Word[Start - 1]));
+					if(bStartsToken)
+					{
+						TArray<int32>& TokenResultIndices = TokenMap.FindOrAdd(Word.Mid(Start).ToLower());
+						if(TokenResultIndices.Num() == 0 || TokenResultIndices.Last() != ResultIndex)
+						{
+							TokenResultIndices.Add(ResultIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	TokenMap.KeySort(TLess<FString>());
+	Tokens.Reserve(TokenMap.Num());
+	TokenResults.Reserve(TokenMap.Num());
+	for(TPair<FString, TArray<int32>>& Token : TokenMap)
+	{
+		Tokens.Add(Token.Key);
+		TokenResults.Add(MoveTemp(Token.Value));
+	}
+	bIsBuilt = true;
+}
+
+void FHardReferenceFinderFilter::MarkMatchingResults(const FString& Word, bool bIsExact, TBitArray<>& OutResults) const
+{
+	OutResults.Init(false, NumResults);
+
+	// Tokens are sorted, so every token starting with the word is in one contiguous range starting with the word itself
+	for(int32 TokenIndex = Algo::LowerBound(Tokens, Word); TokenIndex < Tokens.Num() && Tokens[TokenIndex].StartsWith(Word, ESearchCase::CaseSensitive); ++TokenIndex)
+	{
+		if(bIsExact && Tokens[TokenIndex].Len() != Word.Len())
+		{
+			break;
+		}
+
+		for(const int32 ResultIndex : TokenResults[TokenIndex])
+		{
+			OutResults[ResultIndex] = true;
+		}
+	}
+}
+
+void FHardReferenceFinderFilter::SplitWords(const FString& Text, TArray<FString>& OutWords)
+{
+	int32 WordStart = INDEX_NONE;
+	for(int32 Index = 0; Index <= Text.Len(); ++Index)
+	{
+		const bool bIsWordChar = Index < Text.Len() && FChar::IsAlnum(Text[Index]);
+		if(bIsWordChar && WordStart == INDEX_NONE)
+		{
+			WordStart = Index;
+		}
+		else if(!bIsWordChar && WordStart != INDEX_NONE)
+		{
+			OutWords.Add(Text.Mid(WordStart, Index - WordStart));
+			WordStart = INDEX_NONE;
+		}
+	}
+}
+
+void FHardReferenceFinderFilter::ParseQuery(const FString& Query, TArray<FTerm>& OutTerms)
+{
+	const FString LowerQuery = Query.ToLower();
+	int32 Index = 0;
+	while(Index < LowerQuery.Len())
+	{
+		if(FChar::IsWhitespace(LowerQuery[Index]))
+		{
+			++Index;
+			continue;
+		}
+
+		FTerm Term;
+		if(LowerQuery[Index] == TEXT('-'))
+		{
+			Term.bIsNegated = true;
+			++Index;
+		}
+
+		// A quote that isn't closed yet is still being typed, its words are matched like unquoted ones until it is
+		int32 End = Index;
+		const int32 ClosingQuote = Index < LowerQuery.Len() && LowerQuery[Index] == TEXT('"') ? LowerQuery.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1) : INDEX_NONE;
+		if(ClosingQuote != INDEX_NONE)
+		{
+			Term.bIsQuoted = true;
+			SplitWords(LowerQuery.Mid(Index + 1, ClosingQuote - Index - 1), Term.Words);
+			End = ClosingQuote + 1;
+		}
+		else
+		{
+			while(End < LowerQuery.Len() && !FChar::IsWhitespace(LowerQuery[End]))
+			{
+				++End;
+			}
+			SplitWords(LowerQuery.Mid(Index, End - Index), Term.Words);
+		}
+		Index = End;
+
+		if(Term.Words.Num() > 0)
+		{
+			OutTerms.Add(MoveTemp(Term));
+		}
+	}
+}
+
+bool FHardReferenceFinderFilter::IsNarrowing(const TArray<FTerm>& PreviousTerms, const TArray<FTerm>& Terms)
+{
+	if(PreviousTerms.Num() > Terms.Num())
+	{
+		return false;
+	}
+
+	// Terms added after the previous ones only remove results
+	for(int32 TermIndex = 0; TermIndex < PreviousTerms.Num(); ++TermIndex)
+	{
+		const FTerm& PreviousTerm = PreviousTerms[TermIndex];
+		const FTerm& Term = Terms[TermIndex];
+		if(PreviousTerm == Term)
+		{
+			continue;
+		}
+
+		// The term being typed narrows down as long as it's extended or closed with a quote. Longer negated terms
+		// exclude less, so they widen the query.
+		if(TermIndex != PreviousTerms.Num() - 1 || PreviousTerm.bIsQuoted || PreviousTerm.bIsNegated || Term.bIsNegated || Term.Words.Num() < PreviousTerm.Words.Num())
+		{
+			return false;
+		}
+
+		const int32 LastWord = PreviousTerm.Words.Num() - 1;
+		for(int32 WordIndex = 0; WordIndex < LastWord; ++WordIndex)
+		{
+			if(PreviousTerm.Words[WordIndex] != Term.Words[WordIndex])
+			{
+				return false;
+			}
+		}
+		if(!Term.Words[LastWord].StartsWith(PreviousTerm.Words[LastWord], ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+	return true;
+}
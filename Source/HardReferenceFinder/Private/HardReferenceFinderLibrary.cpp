@@ -0,0 +1,193 @@
+#include "HardReferenceFinderLibrary.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "HardReferenceFinderSearchData.h"
+#include "Async/ParallelFor.h"
+
+namespace HardReferenceLibraryInternals
+{
+	static const int32 MaxPaths = 16;
+
+	/* Results of walking one component, shared by every requested package in it */
+	struct FComponentClosure
+	{
+		int64 TotalSize = 0;
+		int32 NumPackages = 0;
+		TArray<FName> Packages;
+	};
+
+	static FHRFSearchResult MakeSearchResult(FHardReferenceFinderSearchData& SearchData, UObject* Asset)
+	{
+		FHRFSearchResult Result;
+		if(Asset == nullptr)
+		{
+			return Result;
+		}
+
+		Result.PackageName = Asset->GetPackage()->GetFName();
+		const TArray<FHRFTreeViewItemPtr> Items = SearchData.GatherSearchDataForAsset(Asset);
+		Result.NumPackagesReferenced = SearchData.GetNumPackagesReferenced();
+		for(const FHRFTreeViewItemPtr& Item : Items)
+		{
+			// Headers without a package are summaries added for the window, e.g. the total closure. Soft references are
+			// skipped even if the search data was asked for them, the result only describes hard references.
+			if(!Item->bIsHeader || Item->PackageId.IsNone() || Item->bIsSoftReference)
+			{
+				continue;
+			}
+
+			FHRFSearchHeader& Header = Result.Headers.AddDefaulted_GetRef();
+			Header.PackageName = Item->PackageId;
+			Header.AssetClass = Item->AssetClass;
+			Header.Size = Item->SizeOnDisk;
+			for(const FHRFTreeViewItemPtr& Child : Item->Children)
+			{
+				Child->ResolveDisplayInfo();
+				Header.References.Add({Child->Name, Child->Tooltip});
+			}
+		}
+		return Result;
+	}
+}
+
+FHRFClosureInfo UHardReferenceFinderLibrary::GetHardReferenceClosure(FName PackageName, bool bIncludePackages)
+{
+	return GetHardReferenceClosures({PackageName}, bIncludePackages)[0];
+}
+
+TArray<FHRFClosureInfo> UHardReferenceFinderLibrary::GetHardReferenceClosures(const TArray<FName>& PackageNames, bool bIncludePackages)
+{
+	using namespace HardReferenceLibraryInternals;
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+
+	// One snapshot answers the whole batch, the cache keeps it for later calls until the registry changes
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+
+	// Packages in one strongly connected component have the same closure, each component is walked once
+	TArray<FHRFClosureInfo> Closures;
+	Closures.SetNum(PackageNames.Num());
+	TArray<int32> WalkOfClosure;
+	WalkOfClosure.Init(INDEX_NONE, PackageNames.Num());
+	TArray<int32> WalkedComponents;
+	TMap<int32, int32> ComponentToWalk;
+	for(int32 ClosureIndex = 0; ClosureIndex < PackageNames.Num(); ++ClosureIndex)
+	{
+		FHRFClosureInfo& Closure = Closures[ClosureIndex];
+		Closure.PackageName = PackageNames[ClosureIndex];
+		const int32 Package = Graph->FindPackage(Closure.PackageName);
+		if(Package == INDEX_NONE)
+		{
+			continue;
+		}
+
+		Closure.bFound = true;
+		for(const int32 Dependency : Graph->GetDependencies(Package))
+		{
+			Closure.Dependencies.Add(Graph->GetPackageName(Dependency));
+		}
+
+		const int32 Component = Graph->GetComponent(Package);
+		if(const int32* Walk = ComponentToWalk.Find(Component))
+		{
+			WalkOfClosure[ClosureIndex] = *Walk;
+		}
+		else
+		{
+			WalkOfClosure[ClosureIndex] = WalkedComponents.Add(Component);
+			ComponentToWalk.Add(Component, WalkOfClosure[ClosureIndex]);
+		}
+	}
+
+	TArray<FComponentClosure> Walks;
+	Walks.SetNum(WalkedComponents.Num());
+	ParallelFor(WalkedComponents.Num(), [&Graph, &WalkedComponents, &Walks, bIncludePackages](int32 WalkIndex)
+	{
+		LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+		const int32 FirstPackage = Graph->GetComponentPackages(WalkedComponents[WalkIndex])[0];
+		TBitArray<> ClosureComponents(false, Graph->NumComponents());
+		Graph->GatherClosureComponents(FirstPackage, ClosureComponents);
+
+		FComponentClosure& Walk = Walks[WalkIndex];
+		for(TConstSetBitIterator<> It(ClosureComponents); It; ++It)
+		{
+			const TArrayView<const int32> ComponentPackages = Graph->GetComponentPackages(It.GetIndex());
+			Walk.TotalSize += Graph->GetComponentSize(It.GetIndex());
+			Walk.NumPackages += ComponentPackages.Num();
+			if(bIncludePackages)
+			{
+				for(const int32 Package : ComponentPackages)
+				{
+					Walk.Packages.Add(Graph->GetPackageName(Package));
+				}
+			}
+		}
+	});
+
+	for(int32 ClosureIndex = 0; ClosureIndex < Closures.Num(); ++ClosureIndex)
+	{
+		if(WalkOfClosure[ClosureIndex] != INDEX_NONE)
+		{
+			const FComponentClosure& Walk = Walks[WalkOfClosure[ClosureIndex]];
+			Closures[ClosureIndex].TotalSize = Walk.TotalSize;
+			Closures[ClosureIndex].NumPackages = Walk.NumPackages;
+			Closures[ClosureIndex].Packages = Walk.Packages;
+		}
+	}
+	return Closures;
+}
+
+TArray<FName> UHardReferenceFinderLibrary::GetHardReferencers(FName PackageName)
+{
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	TArray<FName> Referencers;
+	const int32 Package = Graph->FindPackage(PackageName);
+	if(Package != INDEX_NONE)
+	{
+		for(const int32 Referencer : Graph->GetReferencers(Package))
+		{
+			Referencers.Add(Graph->GetPackageName(Referencer));
+		}
+	}
+	return Referencers;
+}
+
+TArray<FHRFReferencePath> UHardReferenceFinderLibrary::FindHardReferencePaths(FName FromPackage, FName ToPackage, int32 MaxPaths)
+{
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	TArray<FHRFReferencePath> Paths;
+	const int32 From = Graph->FindPackage(FromPackage);
+	const int32 To = Graph->FindPackage(ToPackage);
+	if(From == INDEX_NONE || To == INDEX_NONE)
+	{
+		return Paths;
+	}
+
+	for(const TArray<int32>& Path : Graph->FindShortestPaths(From, To, FMath::Clamp(MaxPaths, 1, HardReferenceLibraryInternals::MaxPaths)))
+	{
+		FHRFReferencePath& ReferencePath = Paths.AddDefaulted_GetRef();
+		for(const int32 Package : Path)
+		{
+			ReferencePath.Packages.Add(Graph->GetPackageName(Package));
+		}
+	}
+	return Paths;
+}
+
+FHRFSearchResult UHardReferenceFinderLibrary::SearchAsset(UObject* Asset)
+{
+	FHardReferenceFinderSearchData SearchData;
+	return HardReferenceLibraryInternals::MakeSearchResult(SearchData, Asset);
+}
+
+TArray<FHRFSearchResult> UHardReferenceFinderLibrary::SearchAssets(const TArray<UObject*>& Assets)
+{
+	FHardReferenceFinderSearchData SearchData;
+	TArray<FHRFSearchResult> Results;
+	Results.Reserve(Assets.Num());
+	for(UObject* Asset : Assets)
+	{
+		Results.Add(HardReferenceLibraryInternals::MakeSearchResult(SearchData, Asset));
+	}
+	return Results;
+}
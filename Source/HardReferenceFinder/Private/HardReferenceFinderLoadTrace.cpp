@@ -0,0 +1,151 @@
+#include "HardReferenceFinderLoadTrace.h"
+#include "HardReferenceFinderMemory.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+FHardReferenceFinderLoadTrace::~FHardReferenceFinderLoadTrace()
+{
+	Disarm();
+}
+
+void FHardReferenceFinderLoadTrace::Arm(const UClass* InTracedClass)
+{
+	Disarm();
+	TracedClass = InTracedClass;
+	bArmed = true;
+	FEditorDelegates::BeginPIE.AddRaw(this, &FHardReferenceFinderLoadTrace::OnBeginPIE);
+	FEditorDelegates::PostPIEStarted.AddRaw(this, &FHardReferenceFinderLoadTrace::OnPostPIEStarted);
+	FEditorDelegates::EndPIE.AddRaw(this, &FHardReferenceFinderLoadTrace::OnEndPIE);
+}
+
+void FHardReferenceFinderLoadTrace::Disarm()
+{
+	if(bRecording)
+	{
+		StopRecording();
+	}
+	FEditorDelegates::BeginPIE.RemoveAll(this);
+	FEditorDelegates::PostPIEStarted.RemoveAll(this);
+	FEditorDelegates::EndPIE.RemoveAll(this);
+	bArmed = false;
+	Slots.Empty();
+}
+
+void FHardReferenceFinderLoadTrace::OnBeginPIE(bool bIsSimulating)
+{
+	if(bRecording)
+	{
+		return;
+	}
+
+	// Recording starts before the play world is created, so loads made while the map and its actors are set up for
+	// PIE are part of the trace. The buffer is sized up front, recording only ever writes into it.
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Trace);
+	Slots.Reset();
+	Slots.SetNum(Capacity);
+	NextSlot = 0;
+	bRecording = true;
+
+	FCoreDelegates::OnSyncLoadPackage.AddRaw(this, &FHardReferenceFinderLoadTrace::OnSyncLoadPackage);
+	FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FHardReferenceFinderLoadTrace::OnAssetLoaded);
+}
+
+void FHardReferenceFinderLoadTrace::OnPostPIEStarted(bool bIsSimulating)
+{
+	// Spawns can only be watched once the play world exists, placed actors are duplicated into it rather than spawned
+	if(!bRecording || TracedWorld.IsValid())
+	{
+		return;
+	}
+
+	TracedWorld = GEditor ? GEditor->PlayWorld : nullptr;
+	if(TracedWorld.IsValid())
+	{
+		ActorSpawnedHandle = TracedWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FHardReferenceFinderLoadTrace::OnActorSpawned));
+	}
+}
+
+void FHardReferenceFinderLoadTrace::OnEndPIE(bool bIsSimulating)
+{
+	if(!bRecording)
+	{
+		return;
+	}
+	StopRecording();
+
+	// Slots past the end were claimed but never written, anything unpublished was still being written when PIE ended
+	const int32 NumClaimed = FPlatformAtomics::AtomicRead(&NextSlot);
+	TArray<FHRFLoadEvent> Events;
+	Events.Reserve(FMath::Min(NumClaimed, Capacity));
+	for(int32 SlotIndex = 0; SlotIndex < FMath::Min(NumClaimed, Capacity); ++SlotIndex)
+	{
+		if(FPlatformAtomics::AtomicRead(&Slots[SlotIndex].bPublished))
+		{
+			Events.Add(Slots[SlotIndex].Event);
+		}
+	}
+	Events.StableSort([](const FHRFLoadEvent& Lhs, const FHRFLoadEvent& Rhs)
+	{
+		return Lhs.Time < Rhs.Time;
+	});
+	const int32 NumDropped = FMath::Max(NumClaimed - Capacity, 0);
+
+	Disarm();
+	OnTraceFinished.ExecuteIfBound(Events, NumDropped);
+}
+
+void FHardReferenceFinderLoadTrace::OnSyncLoadPackage(const FString& PackageName)
+{
+	Record(FName(*PackageName), EHRFLoadEventType::SyncLoadBegin);
+}
+
+void FHardReferenceFinderLoadTrace::OnAssetLoaded(UObject* Asset)
+{
+	if(Asset)
+	{
+		Record(Asset->GetOutermost()->GetFName(), EHRFLoadEventType::Loaded);
+	}
+}
+
+void FHardReferenceFinderLoadTrace::OnActorSpawned(AActor* Actor)
+{
+	const UClass* Class = TracedClass.Get();
+	if(Actor && Class && Actor->IsA(Class))
+	{
+		Record(Class->GetOutermost()->GetFName(), EHRFLoadEventType::InstanceSpawned);
+	}
+}
+
+void FHardReferenceFinderLoadTrace::Record(FName PackageName, EHRFLoadEventType Type)
+{
+	// Loads can be reported from loading threads as well, each writer owns the slot it claimed
+	const int32 SlotIndex = FPlatformAtomics::InterlockedIncrement(&NextSlot) - 1;
+	if(SlotIndex >= Slots.Num())
+	{
+		return;
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Event.PackageName = PackageName;
+	Slot.Event.Time = FPlatformTime::Seconds();
+	Slot.Event.Type = Type;
+	FPlatformAtomics::InterlockedExchange(&Slot.bPublished, 1);
+}
+
+void FHardReferenceFinderLoadTrace::StopRecording()
+{
+	FCoreDelegates::OnSyncLoadPackage.RemoveAll(this);
+	FCoreUObjectDelegates::OnAssetLoaded.RemoveAll(this);
+	if(TracedWorld.IsValid())
+	{
+		TracedWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	TracedWorld.Reset();
+	ActorSpawnedHandle.Reset();
+	bRecording = false;
+}
@@ -0,0 +1,26 @@
+#include "HardReferenceFinderMemory.h"
+
+LLM_DEFINE_TAG(HardReferenceFinder);
+LLM_DEFINE_TAG(HardReferenceFinder_Search, TEXT("Search"), TEXT("HardReferenceFinder"));
+LLM_DEFINE_TAG(HardReferenceFinder_Cache, TEXT("Cache"), TEXT("HardReferenceFinder"));
+LLM_DEFINE_TAG(HardReferenceFinder_Graph, TEXT("Graph"), TEXT("HardReferenceFinder"));
+LLM_DEFINE_TAG(HardReferenceFinder_History, TEXT("History"), TEXT("HardReferenceFinder"));
+LLM_DEFINE_TAG(HardReferenceFinder_Trace, TEXT("Trace"), TEXT("HardReferenceFinder"));
+LLM_DEFINE_TAG(HardReferenceFinder_UI, TEXT("UI"), TEXT("HardReferenceFinder"));
+
+DEFINE_STAT(STAT_HRF_NumResultItems);
+DEFINE_STAT(STAT_HRF_NumClassAnalyses);
+DEFINE_STAT(STAT_HRF_ClassAnalysisMemory);
+DEFINE_STAT(STAT_HRF_NumClosureSizes);
+DEFINE_STAT(STAT_HRF_ClosureSizeMemory);
+DEFINE_STAT(STAT_HRF_NumGraphPackages);
+DEFINE_STAT(STAT_HRF_GraphMemory);
+DEFINE_STAT(STAT_HRF_NumCookedRegistries);
+DEFINE_STAT(STAT_HRF_CookedRegistryMemory);
+DEFINE_STAT(STAT_HRF_NumHistorySamples);
+DEFINE_STAT(STAT_HRF_HistoryMemory);
+DEFINE_STAT(STAT_HRF_ScratchAllocations);
+DEFINE_STAT(STAT_HRF_NumPendingSearches);
+DEFINE_STAT(STAT_HRF_NumCoalescedSearches);
+DEFINE_STAT(STAT_HRF_NumCookReportBlueprints);
+DEFINE_STAT(STAT_HRF_CookReportScan);
@@ -0,0 +1,293 @@
+#include "HardReferenceFinderQueryService.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHardReferenceQueryService, Log, All);
+
+TUniquePtr<FHardReferenceFinderQueryService> FHardReferenceFinderQueryService::Instance;
+
+namespace HardReferenceQueryInternals
+{
+	static TAutoConsoleVariable<int32> CVarEnableQueryService(
+		TEXT("HardReferenceFinder.QueryService.Enable"),
+		0,
+		TEXT("Serves closure, referencer and path queries as JSON for external tools, on the loopback address only. Off by default."));
+
+	static TAutoConsoleVariable<int32> CVarQueryServicePort(
+		TEXT("HardReferenceFinder.QueryService.Port"),
+		8765,
+		TEXT("Port the hard reference query service listens on."));
+
+	// Large closures are split into pages so a single response never holds the whole project
+	static const int32 DefaultPageSize = 1000;
+	static const int32 MaxPageSize = 10000;
+	static const int32 MaxPaths = 16;
+
+	static int32 GetIntField(const FJsonObject& Object, const FString& FieldName, int32 DefaultValue)
+	{
+		int32 Value = DefaultValue;
+		Object.TryGetNumberField(FieldName, Value);
+		return Value;
+	}
+
+	// The engine's HTTP server binds to DefaultBindAddress, which a project may point at every interface. Dependency data
+	// must not be served to the network, so the listener for the port is pinned to loopback before it is created.
+	static void PinListenerToLoopback(int32 Port)
+	{
+		const TCHAR* Section = TEXT("HTTPServer.Listeners");
+		TArray<FString> Overrides;
+		GConfig->GetArray(Section, TEXT("ListenerOverrides"), Overrides, GEngineIni);
+		Overrides.RemoveAll([Port](const FString& Override)
+		{
+			int32 OverridePort = 0;
+			return FParse::Value(*Override, TEXT("Port="), OverridePort) && OverridePort == Port;
+		});
+		Overrides.Add(FString::Printf(TEXT("(Port=%d,BindAddress=127.0.0.1)"), Port));
+		GConfig->SetArray(Section, TEXT("ListenerOverrides"), Overrides, GEngineIni);
+	}
+
+	static TSharedRef<FJsonValue> MakePackageValue(const FHardReferenceFinderDependencyGraph& Graph, int32 Package)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("package"), Graph.GetPackageName(Package).ToString());
+		Object->SetNumberField(TEXT("size"), static_cast<double>(Graph.GetDiskSize(Package)));
+		return MakeShared<FJsonValueObject>(Object);
+	}
+
+	// Only the packages of the requested page are turned into JSON, the rest of the list stays as graph indices
+	static void AddPackagePage(FJsonObject& OutResult, const FString& FieldName, const FHardReferenceFinderDependencyGraph& Graph, TArrayView<const int32> Packages, const FJsonObject& Query)
+	{
+		const int32 Offset = FMath::Clamp(GetIntField(Query, TEXT("offset"), 0), 0, Packages.Num());
+		const int32 Limit = FMath::Clamp(GetIntField(Query, TEXT("limit"), DefaultPageSize), 0, MaxPageSize);
+		const int32 End = FMath::Min(Offset + Limit, Packages.Num());
+
+		TArray<TSharedPtr<FJsonValue>> Page;
+		Page.Reserve(End - Offset);
+		for(int32 Index = Offset; Index < End; ++Index)
+		{
+			Page.Add(MakePackageValue(Graph, Packages[Index]));
+		}
+		OutResult.SetArrayField(FieldName, Page);
+		OutResult.SetNumberField(TEXT("total"), Packages.Num());
+		OutResult.SetNumberField(TEXT("offset"), Offset);
+		OutResult.SetNumberField(TEXT("nextOffset"), End < Packages.Num() ? End : -1);
+	}
+}
+
+void FHardReferenceFinderQueryService::Initialize()
+{
+	if(!Instance.IsValid())
+	{
+		Instance = MakeUnique<FHardReferenceFinderQueryService>();
+
+		// The service follows the console variables, so it can also be enabled from an ini or the command line
+		const FConsoleVariableDelegate OnChanged = FConsoleVariableDelegate::CreateRaw(Instance.Get(), &FHardReferenceFinderQueryService::OnSettingsChanged);
+		HardReferenceQueryInternals::CVarEnableQueryService->SetOnChangedCallback(OnChanged);
+		HardReferenceQueryInternals::CVarQueryServicePort->SetOnChangedCallback(OnChanged);
+		Instance->OnSettingsChanged(nullptr);
+	}
+}
+
+void FHardReferenceFinderQueryService::Shutdown()
+{
+	if(Instance.IsValid())
+	{
+		HardReferenceQueryInternals::CVarEnableQueryService->SetOnChangedCallback(FConsoleVariableDelegate());
+		HardReferenceQueryInternals::CVarQueryServicePort->SetOnChangedCallback(FConsoleVariableDelegate());
+		Instance.Reset();
+	}
+}
+
+FHardReferenceFinderQueryService::~FHardReferenceFinderQueryService()
+{
+	Stop();
+}
+
+void FHardReferenceFinderQueryService::OnSettingsChanged(IConsoleVariable* Variable)
+{
+	const bool bEnabled = HardReferenceQueryInternals::CVarEnableQueryService.GetValueOnGameThread() != 0;
+	const int32 Port = HardReferenceQueryInternals::CVarQueryServicePort.GetValueOnGameThread();
+	if(!bEnabled)
+	{
+		Stop();
+	}
+	else if(!Router.IsValid() || Port != ListeningPort)
+	{
+		Stop();
+		Start(Port);
+	}
+}
+
+void FHardReferenceFinderQueryService::Start(int32 Port)
+{
+	HardReferenceQueryInternals::PinListenerToLoopback(Port);
+	FHttpServerModule& HttpServerModule = FHttpServerModule::Get();
+	Router = HttpServerModule.GetHttpRouter(Port);
+	if(!Router.IsValid())
+	{
+		UE_LOG(LogHardReferenceQueryService, Warning, TEXT("Hard reference query service could not listen on port %d"), Port);
+		return;
+	}
+
+	RouteHandle = Router->BindRoute(FHttpPath(TEXT("/hardreferences")), EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return HandleRequest(Request, OnComplete);
+		});
+	ListeningPort = Port;
+	HttpServerModule.StartAllListeners();
+}
+
+void FHardReferenceFinderQueryService::Stop()
+{
+	if(Router.IsValid() && RouteHandle.IsValid())
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+	RouteHandle.Reset();
+	Router.Reset();
+	ListeningPort = 0;
+}
+
+bool FHardReferenceFinderQueryService::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+	TArray<TSharedPtr<FJsonValue>> Queries;
+	if(Request.Verb == EHttpServerRequestVerbs::VERB_GET)
+	{
+		TSharedRef<FJsonObject> Query = MakeShared<FJsonObject>();
+		for(const TPair<FString, FString>& Param : Request.QueryParams)
+		{
+			Query->SetStringField(Param.Key, Param.Value);
+		}
+		Queries.Add(MakeShared<FJsonValueObject>(Query));
+	}
+	else
+	{
+		const FUTF8ToTCHAR BodyText(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		TSharedPtr<FJsonObject> Body;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(BodyText.Length(), BodyText.Get()));
+		const TArray<TSharedPtr<FJsonValue>>* BodyQueries = nullptr;
+		if(!FJsonSerializer::Deserialize(Reader, Body) || !Body.IsValid() || !Body->TryGetArrayField(TEXT("queries"), BodyQueries))
+		{
+			OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("InvalidRequest"), TEXT("Expected a JSON object with a \"queries\" array")));
+			return true;
+		}
+		Queries = *BodyQueries;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	Results.Reserve(Queries.Num());
+	for(const TSharedPtr<FJsonValue>& Query : Queries)
+	{
+		const TSharedPtr<FJsonObject>* QueryObject = nullptr;
+		if(Query.IsValid() && Query->TryGetObject(QueryObject))
+		{
+			Results.Add(MakeShared<FJsonValueObject>(RunQuery(**QueryObject)));
+		}
+		else
+		{
+			TSharedRef<FJsonObject> Error = MakeShared<FJsonObject>();
+			Error->SetStringField(TEXT("error"), TEXT("Queries must be objects"));
+			Results.Add(MakeShared<FJsonValueObject>(Error));
+		}
+	}
+
+	TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetArrayField(TEXT("results"), Results);
+	FString ResponseText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseText);
+	FJsonSerializer::Serialize(Response, Writer);
+	OnComplete(FHttpServerResponse::Create(ResponseText, TEXT("application/json")));
+	return true;
+}
+
+TSharedRef<FJsonObject> FHardReferenceFinderQueryService::RunQuery(const FJsonObject& Query) const
+{
+	using namespace HardReferenceQueryInternals;
+
+	// Requests are handled on the game thread, so the shared graph can be used as is
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	FString Type;
+	Query.TryGetStringField(TEXT("type"), Type);
+	Result->SetStringField(TEXT("type"), Type);
+
+	const auto FindPackage = [&Graph, &Query, &Result](const FString& FieldName)
+	{
+		FString PackageName;
+		Query.TryGetStringField(FieldName, PackageName);
+		const int32 Package = Graph->FindPackage(FName(*PackageName));
+		Result->SetStringField(FieldName, PackageName);
+		if(Package == INDEX_NONE)
+		{
+			Result->SetStringField(TEXT("error"), FString::Printf(TEXT("%s is not in the asset registry"), *PackageName));
+		}
+		return Package;
+	};
+
+	if(Type == TEXT("closure"))
+	{
+		const int32 Package = FindPackage(TEXT("package"));
+		if(Package != INDEX_NONE)
+		{
+			Result->SetNumberField(TEXT("closureSize"), static_cast<double>(Graph->GetClosureSize(Package)));
+
+			TBitArray<> Closure(false, Graph->NumComponents());
+			Graph->GatherClosureComponents(Package, Closure);
+			TArray<int32> Packages;
+			for(TConstSetBitIterator<> It(Closure); It; ++It)
+			{
+				const TArrayView<const int32> ComponentPackages = Graph->GetComponentPackages(It.GetIndex());
+				Packages.Append(ComponentPackages.GetData(), ComponentPackages.Num());
+			}
+
+			// Sorted so every page of the same closure is cut from the same order
+			Packages.Sort();
+			AddPackagePage(*Result, TEXT("packages"), *Graph, Packages, Query);
+		}
+	}
+	else if(Type == TEXT("referencers"))
+	{
+		const int32 Package = FindPackage(TEXT("package"));
+		if(Package != INDEX_NONE)
+		{
+			AddPackagePage(*Result, TEXT("referencers"), *Graph, Graph->GetReferencers(Package), Query);
+		}
+	}
+	else if(Type == TEXT("path"))
+	{
+		const int32 From = FindPackage(TEXT("from"));
+		const int32 To = FindPackage(TEXT("to"));
+		if(From != INDEX_NONE && To != INDEX_NONE)
+		{
+			TArray<TSharedPtr<FJsonValue>> Paths;
+			for(const TArray<int32>& Path : Graph->FindShortestPaths(From, To, FMath::Clamp(GetIntField(Query, TEXT("maxPaths"), 1), 1, MaxPaths)))
+			{
+				TArray<TSharedPtr<FJsonValue>> PathPackages;
+				for(const int32 PathPackage : Path)
+				{
+					PathPackages.Add(MakeShared<FJsonValueString>(Graph->GetPackageName(PathPackage).ToString()));
+				}
+				Paths.Add(MakeShared<FJsonValueArray>(PathPackages));
+			}
+			Result->SetArrayField(TEXT("paths"), Paths);
+		}
+	}
+	else
+	{
+		Result->SetStringField(TEXT("error"), TEXT("Unknown query type, expected closure, referencers or path"));
+	}
+	return Result;
+}
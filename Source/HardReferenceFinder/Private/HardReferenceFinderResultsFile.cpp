@@ -0,0 +1,294 @@
+#include "HardReferenceFinderResultsFile.h"
+#include "HardReferenceFinderSnapshot.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+using namespace HardReferenceResultsFormat;
+
+// Records are written and read in native byte order, all of the editor platforms are little endian.
+static_assert(PLATFORM_LITTLE_ENDIAN, "The hard reference results format assumes a little endian platform");
+
+void FHardReferenceFinderResultsWriter::AddBlueprint(const FHardReferenceFinderSnapshot& Snapshot)
+{
+	FBlueprintRecord& BlueprintRecord = Blueprints.AddZeroed_GetRef();
+	BlueprintRecord.NameIndex = AddString(Snapshot.GetBlueprintPackage().ToString());
+	BlueprintRecord.FirstPackage = Packages.Num();
+	BlueprintRecord.NumPackages = Snapshot.GetPackages().Num();
+	BlueprintRecord.ClosureSize = Snapshot.GetClosureSize();
+
+	for(const FHRFSnapshotPackage& Package : Snapshot.GetPackages())
+	{
+		FPackageRecord& PackageRecord = Packages.AddZeroed_GetRef();
+		PackageRecord.NameIndex = AddString(Package.PackageId.ToString());
+		PackageRecord.FirstSource = Sources.Num();
+		PackageRecord.NumSources = Package.Sources.Num();
+		PackageRecord.SizeOnDisk = Package.SizeOnDisk;
+
+		for(const FHRFSnapshotSource& Source : Package.Sources)
+		{
+			FSourceRecord& SourceRecord = Sources.AddZeroed_GetRef();
+			SourceRecord.NodeGuid = Source.NodeGuid;
+			SourceRecord.NameIndex = AddString(Source.Name);
+			SourceRecord.SCSIdentifierIndex = Source.SCSIdentifier.IsNone() ? InvalidString : AddString(Source.SCSIdentifier.ToString());
+		}
+	}
+}
+
+uint32 FHardReferenceFinderResultsWriter::AddString(const FString& String)
+{
+	if(const uint32* ExistingIndex = StringToIndex.Find(String))
+	{
+		return *ExistingIndex;
+	}
+
+	const uint32 NewIndex = Strings.Add(String);
+	StringToIndex.Add(String, NewIndex);
+	return NewIndex;
+}
+
+bool FHardReferenceFinderResultsWriter::SaveToFile(const FString& FileName)
+{
+	// Readers binary search the blueprint table, so it is written sorted by name
+	TArray<FBlueprintRecord> SortedBlueprints = Blueprints;
+	SortedBlueprints.Sort([this](const FBlueprintRecord& Lhs, const FBlueprintRecord& Rhs)
+	{
+		return Strings[Lhs.NameIndex].Compare(Strings[Rhs.NameIndex], ESearchCase::IgnoreCase) < 0;
+	});
+
+	TArray<uint32> StringOffsets;
+	TArray<ANSICHAR> StringData;
+	StringOffsets.Reserve(Strings.Num() + 1);
+	for(const FString& String : Strings)
+	{
+		StringOffsets.Add(StringData.Num());
+		const FTCHARToUTF8 Converted(*String);
+		StringData.Append(Converted.Get(), Converted.Length());
+	}
+	StringOffsets.Add(StringData.Num());
+
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = HardReferenceResultsFormat::Magic;
+	Header.Version = static_cast<uint32>(EVersion::Latest);
+	Header.NumBlueprints = SortedBlueprints.Num();
+	Header.NumPackages = Packages.Num();
+	Header.NumSources = Sources.Num();
+	Header.NumStrings = Strings.Num();
+	Header.BlueprintTableOffset = sizeof(FHeader);
+	Header.PackageTableOffset = Header.BlueprintTableOffset + SortedBlueprints.Num() * sizeof(FBlueprintRecord);
+	Header.SourceTableOffset = Header.PackageTableOffset + Packages.Num() * sizeof(FPackageRecord);
+	Header.StringOffsetsOffset = Header.SourceTableOffset + Sources.Num() * sizeof(FSourceRecord);
+	Header.StringDataOffset = Header.StringOffsetsOffset + StringOffsets.Num() * sizeof(uint32);
+	Header.StringDataSize = StringData.Num();
+
+	const TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FileName));
+	if(!Writer.IsValid())
+	{
+		return false;
+	}
+
+	Writer->Serialize(&Header, sizeof(FHeader));
+	Writer->Serialize(SortedBlueprints.GetData(), SortedBlueprints.Num() * sizeof(FBlueprintRecord));
+	Writer->Serialize(Packages.GetData(), Packages.Num() * sizeof(FPackageRecord));
+	Writer->Serialize(Sources.GetData(), Sources.Num() * sizeof(FSourceRecord));
+	Writer->Serialize(StringOffsets.GetData(), StringOffsets.Num() * sizeof(uint32));
+	Writer->Serialize(StringData.GetData(), StringData.Num());
+
+	return Writer->Close();
+}
+
+FHardReferenceFinderResultsFile::~FHardReferenceFinderResultsFile()
+{
+	// The region has to be released before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+TUniquePtr<FHardReferenceFinderResultsFile> FHardReferenceFinderResultsFile::Open(const FString& FileName)
+{
+	TUniquePtr<FHardReferenceFinderResultsFile> ResultsFile(new FHardReferenceFinderResultsFile());
+
+	ResultsFile->MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FileName));
+	if(ResultsFile->MappedHandle.IsValid())
+	{
+		ResultsFile->MappedRegion.Reset(ResultsFile->MappedHandle->MapRegion(0, ResultsFile->MappedHandle->GetFileSize()));
+	}
+
+	if(ResultsFile->MappedRegion.IsValid())
+	{
+		ResultsFile->Data = ResultsFile->MappedRegion->GetMappedPtr();
+		ResultsFile->DataSize = ResultsFile->MappedRegion->GetMappedSize();
+	}
+	else if(FFileHelper::LoadFileToArray(ResultsFile->FallbackBytes, *FileName, FILEREAD_Silent))
+	{
+		ResultsFile->Data = ResultsFile->FallbackBytes.GetData();
+		ResultsFile->DataSize = ResultsFile->FallbackBytes.Num();
+	}
+
+	if(!ResultsFile->Initialize())
+	{
+		return nullptr;
+	}
+	return ResultsFile;
+}
+
+bool FHardReferenceFinderResultsFile::Initialize()
+{
+	if(Data == nullptr || DataSize < static_cast<int64>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	Header = reinterpret_cast<const FHeader*>(Data);
+	if(Header->Magic != HardReferenceResultsFormat::Magic || Header->Version == 0 || Header->Version > static_cast<uint32>(EVersion::Latest))
+	{
+		return false;
+	}
+
+	// Validate every section up front so that record access afterwards doesn't need bounds checks
+	auto IsSectionValid = [this](uint64 Offset, uint64 Count, uint64 Stride)
+	{
+		return Offset <= static_cast<uint64>(DataSize) && Count <= (static_cast<uint64>(DataSize) - Offset) / Stride;
+	};
+	if(!IsSectionValid(Header->BlueprintTableOffset, Header->NumBlueprints, sizeof(FBlueprintRecord))
+		|| !IsSectionValid(Header->PackageTableOffset, Header->NumPackages, sizeof(FPackageRecord))
+		|| !IsSectionValid(Header->SourceTableOffset, Header->NumSources, sizeof(FSourceRecord))
+		|| !IsSectionValid(Header->StringOffsetsOffset, static_cast<uint64>(Header->NumStrings) + 1, sizeof(uint32))
+		|| !IsSectionValid(Header->StringDataOffset, Header->StringDataSize, 1))
+	{
+		return false;
+	}
+
+	BlueprintTable = reinterpret_cast<const FBlueprintRecord*>(Data + Header->BlueprintTableOffset);
+	PackageTable = reinterpret_cast<const FPackageRecord*>(Data + Header->PackageTableOffset);
+	SourceTable = reinterpret_cast<const FSourceRecord*>(Data + Header->SourceTableOffset);
+	StringOffsets = reinterpret_cast<const uint32*>(Data + Header->StringOffsetsOffset);
+	StringData = reinterpret_cast<const ANSICHAR*>(Data + Header->StringDataOffset);
+	return true;
+}
+
+int32 FHardReferenceFinderResultsFile::GetNumBlueprints() const
+{
+	return Header->NumBlueprints;
+}
+
+FName FHardReferenceFinderResultsFile::GetBlueprintName(int32 BlueprintIndex) const
+{
+	if(!ensure(static_cast<uint32>(BlueprintIndex) < Header->NumBlueprints))
+	{
+		return NAME_None;
+	}
+	return FName(*GetString(BlueprintTable[BlueprintIndex].NameIndex));
+}
+
+int64 FHardReferenceFinderResultsFile::GetBlueprintClosureSize(int32 BlueprintIndex) const
+{
+	// Older files stored the sum of overlapping header sizes, which says nothing about the closure
+	if(!ensure(static_cast<uint32>(BlueprintIndex) < Header->NumBlueprints) || Header->Version < static_cast<uint32>(EVersion::ClosureSize))
+	{
+		return 0;
+	}
+	return BlueprintTable[BlueprintIndex].ClosureSize;
+}
+
+int32 FHardReferenceFinderResultsFile::FindBlueprint(FName BlueprintPackage) const
+{
+	if(BlueprintPackage.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	const FString BlueprintName = BlueprintPackage.ToString();
+	int32 Low = 0;
+	int32 High = static_cast<int32>(Header->NumBlueprints) - 1;
+	while(Low <= High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+		const int32 Comparison = CompareString(BlueprintTable[Middle].NameIndex, BlueprintName);
+		if(Comparison == 0)
+		{
+			return Middle;
+		}
+
+		if(Comparison < 0)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle - 1;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FHardReferenceFinderResultsFile::ReadBlueprint(int32 BlueprintIndex, FHardReferenceFinderSnapshot& OutSnapshot) const
+{
+	if(static_cast<uint32>(BlueprintIndex) >= Header->NumBlueprints)
+	{
+		return false;
+	}
+
+	const FBlueprintRecord& BlueprintRecord = BlueprintTable[BlueprintIndex];
+	if(static_cast<uint64>(BlueprintRecord.FirstPackage) + BlueprintRecord.NumPackages > Header->NumPackages)
+	{
+		return false;
+	}
+
+	TArray<FHRFSnapshotPackage> Packages;
+	Packages.Reserve(BlueprintRecord.NumPackages);
+	for(uint32 PackageIndex = 0; PackageIndex < BlueprintRecord.NumPackages; ++PackageIndex)
+	{
+		const FPackageRecord& PackageRecord = PackageTable[BlueprintRecord.FirstPackage + PackageIndex];
+		if(static_cast<uint64>(PackageRecord.FirstSource) + PackageRecord.NumSources > Header->NumSources)
+		{
+			return false;
+		}
+
+		FHRFSnapshotPackage& Package = Packages.AddDefaulted_GetRef();
+		Package.PackageId = FName(*GetString(PackageRecord.NameIndex));
+		Package.SizeOnDisk = PackageRecord.SizeOnDisk;
+		Package.Sources.Reserve(PackageRecord.NumSources);
+
+		for(uint32 SourceIndex = 0; SourceIndex < PackageRecord.NumSources; ++SourceIndex)
+		{
+			const FSourceRecord& SourceRecord = SourceTable[PackageRecord.FirstSource + SourceIndex];
+
+			FHRFSnapshotSource& Source = Package.Sources.AddDefaulted_GetRef();
+			Source.Name = GetString(SourceRecord.NameIndex);
+			Source.NodeGuid = SourceRecord.NodeGuid;
+			if(SourceRecord.SCSIdentifierIndex != InvalidString)
+			{
+				Source.SCSIdentifier = FName(*GetString(SourceRecord.SCSIdentifierIndex));
+			}
+		}
+	}
+
+	OutSnapshot = FHardReferenceFinderSnapshot(GetBlueprintName(BlueprintIndex), MoveTemp(Packages), GetBlueprintClosureSize(BlueprintIndex));
+	return true;
+}
+
+FString FHardReferenceFinderResultsFile::GetString(uint32 StringIndex) const
+{
+	if(StringIndex >= Header->NumStrings)
+	{
+		return FString();
+	}
+
+	const uint32 Begin = StringOffsets[StringIndex];
+	const uint32 End = StringOffsets[StringIndex + 1];
+	if(Begin > End || End > Header->StringDataSize)
+	{
+		return FString();
+	}
+
+	const FUTF8ToTCHAR Converted(StringData + Begin, End - Begin);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+int32 FHardReferenceFinderResultsFile::CompareString(uint32 StringIndex, const FString& Other) const
+{
+	return GetString(StringIndex).Compare(Other, ESearchCase::IgnoreCase);
+}
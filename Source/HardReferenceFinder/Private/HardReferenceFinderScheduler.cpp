@@ -0,0 +1,174 @@
+#include "HardReferenceFinderScheduler.h"
+#include "HardReferenceFinderMemory.h"
+#include "BlueprintEditor.h"
+#include "Engine/World.h"
+
+TUniquePtr<FHardReferenceFinderScheduler> FHardReferenceFinderScheduler::Instance;
+
+void FHardReferenceFinderScheduler::Initialize()
+{
+	if(!Instance.IsValid())
+	{
+		Instance = MakeUnique<FHardReferenceFinderScheduler>();
+	}
+}
+
+void FHardReferenceFinderScheduler::Shutdown()
+{
+	if(Instance.IsValid())
+	{
+		if(Instance->TickerHandle.IsValid())
+		{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+			FTicker::GetCoreTicker().RemoveTicker(Instance->TickerHandle);
+#else
+			FTSTicker::GetCoreTicker().RemoveTicker(Instance->TickerHandle);
+#endif
+		}
+		Instance->Jobs.Reset();
+		Instance->UpdateStats();
+		Instance.Reset();
+	}
+}
+
+FHardReferenceFinderScheduler& FHardReferenceFinderScheduler::Get()
+{
+	check(Instance.IsValid());
+	return *Instance;
+}
+
+void FHardReferenceFinderScheduler::RequestSearch(const void* Owner, const FHRFSearchRequest& Request, FOnHRFGetSearchPriority GetPriority, FOnHRFSearchFinished OnFinished)
+{
+	check(IsInGameThread());
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+	CancelSearches(Owner);
+
+	FWaiter Waiter;
+	Waiter.Owner = Owner;
+	Waiter.GetPriority = MoveTemp(GetPriority);
+	Waiter.OnFinished = MoveTemp(OnFinished);
+
+	if(FJob* Existing = Jobs.FindByPredicate([&Request](const FJob& Job) { return Job.Request == Request; }))
+	{
+		// The blueprint editor may have been reopened since the job was queued, the newest one is searched
+		if(Request.BlueprintEditor.IsValid())
+		{
+			Existing->Request.BlueprintEditor = Request.BlueprintEditor;
+		}
+		Existing->Waiters.Add(MoveTemp(Waiter));
+		INC_DWORD_STAT(STAT_HRF_NumCoalescedSearches);
+	}
+	else
+	{
+		FJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Request = Request;
+		Job.Waiters.Add(MoveTemp(Waiter));
+	}
+	UpdateStats();
+
+	if(!TickerHandle.IsValid())
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FHardReferenceFinderScheduler::Tick));
+#else
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FHardReferenceFinderScheduler::Tick));
+#endif
+	}
+}
+
+void FHardReferenceFinderScheduler::CancelSearches(const void* Owner)
+{
+	for(FJob& Job : Jobs)
+	{
+		Job.Waiters.RemoveAll([Owner](const FWaiter& Waiter) { return Waiter.Owner == Owner; });
+	}
+	DropUnwantedJobs();
+}
+
+void FHardReferenceFinderScheduler::DropUnwantedJobs()
+{
+	Jobs.RemoveAll([](FJob& Job)
+	{
+		Job.Waiters.RemoveAll([](const FWaiter& Waiter) { return !Waiter.OnFinished.IsBound() || !Waiter.GetPriority.IsBound(); });
+		return Job.Waiters.Num() == 0;
+	});
+	UpdateStats();
+}
+
+bool FHardReferenceFinderScheduler::Tick(float DeltaTime)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+
+	// Windows that closed since the last tick no longer want their results
+	DropUnwantedJobs();
+
+	int32 BestJob = INDEX_NONE;
+	EHRFSearchPriority BestPriority = EHRFSearchPriority::Hidden;
+	for(int32 JobIndex = 0; JobIndex < Jobs.Num() && BestPriority != EHRFSearchPriority::Focused; ++JobIndex)
+	{
+		for(const FWaiter& Waiter : Jobs[JobIndex].Waiters)
+		{
+			const EHRFSearchPriority Priority = Waiter.GetPriority.Execute();
+			if(Priority > BestPriority)
+			{
+				BestJob = JobIndex;
+				BestPriority = Priority;
+			}
+		}
+	}
+
+	if(Jobs.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	if(BestJob == INDEX_NONE)
+	{
+		return true;
+	}
+
+	// Removed before searching, so windows can queue new requests from their callbacks
+	FJob Job = MoveTemp(Jobs[BestJob]);
+	Jobs.RemoveAt(BestJob);
+	UpdateStats();
+
+	const TSharedRef<const FHRFSearchOutcome> Outcome = RunSearch(Job.Request);
+	for(const FWaiter& Waiter : Job.Waiters)
+	{
+		Waiter.OnFinished.ExecuteIfBound(Outcome);
+	}
+	return true;
+}
+
+TSharedRef<const FHRFSearchOutcome> FHardReferenceFinderScheduler::RunSearch(const FHRFSearchRequest& Request)
+{
+	const TSharedRef<FHRFSearchOutcome> Outcome = MakeShared<FHRFSearchOutcome>();
+	SearchData.SetSizePlatform(Request.SizePlatform);
+	SearchData.SetIncludeSoftReferences(Request.bIncludeSoftReferences);
+	switch(Request.Target)
+	{
+	case EHRFSearchTarget::Blueprint:
+		Outcome->Results = SearchData.GatherSearchData(Request.BlueprintEditor);
+		break;
+	case EHRFSearchTarget::World:
+		Outcome->Results = SearchData.GatherSearchDataForWorld(Cast<UWorld>(Request.Object.Get()));
+		break;
+	case EHRFSearchTarget::Asset:
+		Outcome->Results = SearchData.GatherSearchDataForAsset(Request.Object.Get());
+		break;
+	}
+
+	Outcome->NumPackagesReferenced = SearchData.GetNumPackagesReferenced();
+	Outcome->NumSoftPackagesReferenced = SearchData.GetNumSoftPackagesReferenced();
+	Outcome->SizePlatform = Request.SizePlatform;
+	Outcome->bUsingCookedSizes = SearchData.IsUsingCookedSizes();
+	Outcome->OwnChunkList = SearchData.GetOwnChunkList();
+	Outcome->ForeignChunkSize = SearchData.GetForeignChunkSize();
+	Outcome->SearchedClosure = SearchData.GetSearchedClosure();
+	return Outcome;
+}
+
+void FHardReferenceFinderScheduler::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_HRF_NumPendingSearches, Jobs.Num());
+}
@@ -1,14 +1,34 @@
 ﻿#include "HardReferenceFinderSearchData.h"
 #include "AssetToolsModule.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderCookedRegistry.h"
+#include "HardReferenceFinderTextUtils.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "BlueprintEditor.h"
+#include "Blueprint/WidgetTree.h"
 #include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/DataTable.h"
+#include "Engine/Font.h"
+#include "Engine/Level.h"
+#include "Engine/LevelScriptBlueprint.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_DynamicCast.h"
 #include "K2Node_FunctionEntry.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpression.h"
+#include "Materials/MaterialInstance.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
 #include "Styling/SlateIconFinder.h"
+#include "WidgetBlueprint.h"
 
 #if ENGINE_MAJOR_VERSION < 5
 #include "SSCSEditor.h"
@@ -16,94 +36,1062 @@
 #include "SSubobjectEditor.h"
 #endif
 
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
 
+namespace HardReferenceSearchInternals
+{
+	// "/Game/Characters/Hero/Mesh" belongs to "/Game/Characters", packages directly in a mount point to the mount point
+	static FName GetTopLevelFolder(FName PackageName)
+	{
+		const FString PackageString = PackageName.ToString();
+		const int32 MountEnd = PackageString.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1);
+		if(MountEnd == INDEX_NONE)
+		{
+			return PackageName;
+		}
+
+		const int32 FolderEnd = PackageString.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, MountEnd + 1);
+		return FName(*PackageString.Left(FolderEnd == INDEX_NONE ? MountEnd : FolderEnd));
+	}
+
+	// Number of graph nodes scanned by each parallel task
+	static const int32 GraphNodesPerBatch = 256;
+
+	// Data table rows a worker claims at a time, small enough to balance uneven rows across workers
+	static const int32 DataTableRowsPerBatch = 64;
+
+	/*
+	 * Makes the search's collector available to its property walks for the scope of one search, then reports how often
+	 * it grew. The collector is emptied on the way out, packages it still listed could be garbage collected before the
+	 * next search.
+	 */
+	struct FSearchScratch
+	{
+		FSearchScratch(FHRFPackageCollector*& InOutActivePackages, FHRFPackageCollector& InPackages, FThreadSafeCounter& InNumAllocations)
+			: ActivePackages(InOutActivePackages)
+			, Packages(InPackages)
+			, NumAllocations(InNumAllocations)
+		{
+			ActivePackages = &Packages;
+		}
+
+		~FSearchScratch()
+		{
+			Packages.Reset();
+			ActivePackages = nullptr;
+			SET_DWORD_STAT(STAT_HRF_ScratchAllocations, NumAllocations.GetValue());
+		}
+
+		FHRFPackageCollector*& ActivePackages;
+		FHRFPackageCollector& Packages;
+		FThreadSafeCounter& NumAllocations;
+	};
+
+	/* A package referenced by a graph node, or by the default value of one of its pins when PinName is set */
+	struct FGraphNodeReference
+	{
+		FName PackageName;
+		int32 NodeIndex;
+		FName PinName;
+		bool bIsSoft = false;
+	};
+
+	// Soft object and soft class properties, and FSoftObjectPath or FSoftClassPath structs
+	static bool IsSoftValueProperty(const FProperty* Property)
+	{
+		if(CastField<FSoftObjectProperty>(Property))
+		{
+			return true;
+		}
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && (StructProperty->Struct == TBaseStructure<FSoftObjectPath>::Get() || StructProperty->Struct == TBaseStructure<FSoftClassPath>::Get());
+	}
+
+	// "Stats.Weapons[2].Mesh", authored names are used so properties of user defined structs read as they were named
+	static FName MakePropertyPath(const TArray<TPair<const FProperty*, int32>>& Path)
+	{
+		FString PathString;
+		for(const TPair<const FProperty*, int32>& Segment : Path)
+		{
+			if(!PathString.IsEmpty())
+			{
+				PathString += TEXT(".");
+			}
+			PathString += Segment.Key->GetAuthoredName();
+			if(Segment.Value != INDEX_NONE)
+			{
+				PathString += FString::Printf(TEXT("[%d]"), Segment.Value);
+			}
+		}
+		return FName(*PathString);
+	}
+
+	// Package of the asset a soft value points at, none when it's empty. Property must pass IsSoftValueProperty().
+	static FName GetSoftValuePackage(const FProperty* Property, const void* ValueAddress)
+	{
+		const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property);
+		const FSoftObjectPath SoftPath = SoftObjectProperty ? SoftObjectProperty->GetPropertyValue(ValueAddress).ToSoftObjectPath() : *static_cast<const FSoftObjectPath*>(ValueAddress);
+		return SoftPath.IsNull() ? NAME_None : FName(*SoftPath.GetLongPackageName());
+	}
+
+	// Runs on worker threads, so it must only read from the node and can't call into the editor
+	static void GatherNodeReferences(TArray<FGraphNodeReference>& OutReferences, const UEdGraphNode* Node, int32 NodeIndex)
+	{
+		if(Node == nullptr)
+		{
+			return;
+		}
+
+		const UPackage* FunctionPackage = nullptr;
+		if(const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			FunctionPackage = CallFunctionNode->FunctionReference.GetMemberParentPackage();
+		}
+		else if(const UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
+		{
+			if(CastNode->TargetType)
+			{
+				FunctionPackage = CastNode->TargetType->GetPackage();
+			}
+		}
+
+		if(FunctionPackage)
+		{
+			OutReferences.Add({FunctionPackage->GetFName(), NodeIndex, NAME_None});
+		}
+
+		// Also search the pins of this node for any references to other packages, e.g. the 'Class' pin of a SpawnActor node.
+		for(const UEdGraphPin* Pin : Node->Pins)
+		{
+			if(Pin->bHidden || Pin->Direction != EGPD_Input)
+			{
+				continue;
+			}
+
+			if(const UObject* PinObject = Pin->DefaultObject)
+			{
+				OutReferences.Add({PinObject->GetPackage()->GetFName(), NodeIndex, Pin->PinName});
+			}
+			else if(!Pin->DefaultValue.IsEmpty() && (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftObject || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftClass))
+			{
+				// Soft pins keep their default as a path, the asset it points at doesn't have to be loaded
+				const FSoftObjectPath SoftPath(Pin->DefaultValue);
+				if(!SoftPath.IsNull())
+				{
+					OutReferences.Add({FName(*SoftPath.GetLongPackageName()), NodeIndex, Pin->PinName, true});
+				}
+			}
+		}
+	}
+}
+
+void FHRFTreeViewItem::SetDeferredName(EHRFDisplayKind InDisplayKind, const FText& InNameFormat, FName InSourceName, FName InSourceContext, const UClass* InSourceClass)
+{
+	DisplayKind = InDisplayKind;
+	NameFormat = InNameFormat;
+	SourceName = InSourceName;
+	SourceContext = InSourceContext;
+	SourceClass = InSourceClass;
+}
+
+void FHRFTreeViewItem::ResolveDisplayInfo(bool bNameOnly)
+{
+	const EHRFDisplayKind Kind = DisplayKind;
+	if(!bNameOnly)
+	{
+		DisplayKind = EHRFDisplayKind::Resolved;
+	}
+
+	if(Kind == EHRFDisplayKind::GraphNode || Kind == EHRFDisplayKind::GraphPin)
+	{
+		const UEdGraphNode* Node = SourceNode.Get();
+		if(Node == nullptr)
+		{
+			Name = LOCTEXT("DeletedNode", "Deleted node");
+			return;
+		}
+
+		const FText NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView);
+		if(Kind == EHRFDisplayKind::GraphNode)
+		{
+			Name = NodeTitle;
+			if(!bNameOnly)
+			{
+				SlateIcon = Node->GetIconAndTint(IconColor);
+			}
+			return;
+		}
+
+		Name = FText::Format(LOCTEXT("FunctionInput","{0} ({1})"), FText::FromName(SourceName), NodeTitle);
+		if(bNameOnly)
+		{
+			return;
+		}
+
+		SlateIcon = FSlateIcon("EditorStyle", "Graph.Pin.Disconnected_VarA");
+		if(const UEdGraphPin* Pin = Node->FindPin(SourceName, EGPD_Input))
+		{
+			if( const UEdGraphSchema* Schema = Pin->GetSchema() )
+			{
+				IconColor = Schema->GetPinTypeColor(Pin->PinType);
+			}
+		}
+	}
+	else if(Kind != EHRFDisplayKind::Resolved)
+	{
+		if(Kind == EHRFDisplayKind::PlacedActor)
+		{
+			// Labels are arbitrary user strings, they're formatted here rather than kept as names by every search
+			const AActor* Actor = Cast<AActor>(SourceObject.Get());
+			const FText Label = Actor ? FText::FromString(Actor->GetActorLabel()) : LOCTEXT("DeletedActor", "Deleted actor");
+			Name = FText::Format(FTextFormat(NameFormat), Label, FText::FromName(SourceName), FText::FromName(SourceContext));
+		}
+		else
+		{
+			Name = FText::Format(FTextFormat(NameFormat), FText::FromName(SourceName), FText::FromName(SourceContext));
+		}
+
+		if(bNameOnly)
+		{
+			return;
+		}
+
+		const UClass* Class = SourceClass.Get();
+		if(Kind == EHRFDisplayKind::Component)
+		{
+			SlateIcon = FSlateIconFinder::FindIconForClass(Class, TEXT("SCS.Component"));
+		}
+		else if(Kind == EHRFDisplayKind::Variable)
+		{
+			UBlueprint* DeclaringBlueprint = Class ? UBlueprint::GetBlueprintFromClass(Class) : nullptr;
+			UBlueprint* FoundBlueprint = nullptr;
+			const int32 VarIndex = DeclaringBlueprint ? FBlueprintEditorUtils::FindNewVariableIndexAndBlueprint(DeclaringBlueprint, SourceName, FoundBlueprint) : INDEX_NONE;
+			if(VarIndex != INDEX_NONE && FoundBlueprint != nullptr)
+			{
+				IconColor = GetDefault<UEdGraphSchema_K2>()->GetPinTypeColor(FoundBlueprint->NewVariables[VarIndex].VarType);
+			}
+		}
+		else if(Class)
+		{
+			SlateIcon = FSlateIconFinder::FindIconForClass(Class);
+		}
+	}
+}
+
+FHardReferenceFinderSearchData::FHardReferenceFinderSearchData()
+	: SearchPackages(NumScratchAllocations)
+{
+}
+
 TArray<FHRFTreeViewItemPtr> FHardReferenceFinderSearchData::GatherSearchData(TWeakPtr<FBlueprintEditor> BlueprintEditor)
 {
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
 	Reset();
+	HardReferenceSearchInternals::FSearchScratch Scratch(ScratchPackages, SearchPackages, NumScratchAllocations);
 
 	TMap<FName, FHRFTreeViewItemPtr> DependentPackageMap;
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	const UBlueprint* SearchedBlueprint = BlueprintEditor.IsValid() ? BlueprintEditor.Pin()->GetBlueprintObj() : nullptr;
+	const FName SearchedPackage = SearchedBlueprint ? SearchedBlueprint->GetPackage()->GetFName() : NAME_None;
 	
 	// Get this blueprints package dependencies from the blueprint editor 
 	TArray<FName> BlueprintDependencies;
 	GetBlueprintDependencies(BlueprintDependencies, AssetRegistryModule, BlueprintEditor);
 	
 	// Populate display information from package dependencies
+	AddPackageHeaders(DependentPackageMap, AssetRegistryModule, BlueprintDependencies);
+	AddSoftPackageHeaders(AssetRegistryModule, {SearchedPackage});
+	
+	{
+		// Search through blueprint nodes for references to the dependent packages
+		if( UBlueprint* Blueprint = BlueprintEditor.Pin()->GetBlueprintObj() )
+		{
+			SearchBlueprint(DependentPackageMap, AssetRegistryModule, Blueprint);
+		}
+	}
+
+	FinalizeSearchResults(AssetRegistryModule, SearchedPackage);
+	return TreeView;
+}
+
+TArray<FHRFTreeViewItemPtr> FHardReferenceFinderSearchData::GatherSearchDataForWorld(UWorld* World)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+	Reset();
+	HardReferenceSearchInternals::FSearchScratch Scratch(ScratchPackages, SearchPackages, NumScratchAllocations);
+
+	if(World == nullptr || World->PersistentLevel == nullptr)
+	{
+		return TreeView;
+	}
+
+	TMap<FName, FHRFTreeViewItemPtr> DependentPackageMap;
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	// The map package itself holds the level script and any actors that aren't saved to their own package
+	const FName WorldPackageName = World->GetPackage()->GetFName();
+	TArray<FName> WorldDependencies;
+	GetPackageDependencies(WorldDependencies, AssetRegistryModule, WorldPackageName);
+	AddPackageHeaders(DependentPackageMap, AssetRegistryModule, WorldDependencies);
+	TArray<FName> SearchedPackages = {WorldPackageName};
+
+	// Loaded streaming sublevels and actors saved in their own package only show up through their package's dependencies
+	for(const ULevel* Level : World->GetLevels())
 	{
-		TMap<FName, FAssetData> DependencyToAssetDataMap;
-		GetAssetForPackages(BlueprintDependencies, DependencyToAssetDataMap);
+		if(Level == nullptr)
+		{
+			continue;
+		}
 
-		for (auto MapIt = DependencyToAssetDataMap.CreateConstIterator(); MapIt; ++MapIt)
+		const FName LevelPackageName = Level->GetPackage()->GetFName();
+		if(!SearchedPackages.Contains(LevelPackageName))
 		{
-			const FName& PathName = MapIt.Key();
-			const FAssetData& AssetData = MapIt.Value();
-			FString AssetTypeName = GetAssetTypeName(AssetData);
-			FString FileName = FPaths::GetCleanFilename(PathName.ToString());
-		
-			FAssetPackageData AssetPackageData;
-			TryGetAssetPackageData(PathName, AssetPackageData, AssetRegistryModule);
+			TArray<FName> LevelDependencies;
+			GetPackageDependencies(LevelDependencies, AssetRegistryModule, LevelPackageName);
+			LevelDependencies.Remove(WorldPackageName);
+			AddPackageHeaders(DependentPackageMap, AssetRegistryModule, LevelDependencies);
+			SearchedPackages.Add(LevelPackageName);
+		}
 
-			if( FHRFTreeViewItemPtr Header = MakeShared<FHRFTreeViewItem>() )
+		for(const AActor* Actor : Level->Actors)
+		{
+			if(Actor && Actor->IsPackageExternal())
 			{
+				TArray<FName> ActorDependencies;
+				GetPackageDependencies(ActorDependencies, AssetRegistryModule, Actor->GetPackage()->GetFName());
+				ActorDependencies.Remove(WorldPackageName);
+				ActorDependencies.Remove(LevelPackageName);
+				AddPackageHeaders(DependentPackageMap, AssetRegistryModule, ActorDependencies);
+				SearchedPackages.Add(Actor->GetPackage()->GetFName());
+			}
+		}
+	}
+	AddSoftPackageHeaders(AssetRegistryModule, SearchedPackages);
+
+	SearchWorldPartitionActors(DependentPackageMap, AssetRegistryModule, World);
+
+	// Every loaded level has a level script of its own
+	for(ULevel* Level : World->GetLevels())
+	{
+		if(Level == nullptr)
+		{
+			continue;
+		}
+
+		if( ULevelScriptBlueprint* LevelScriptBlueprint = Level->GetLevelScriptBlueprint(true) )
+		{
+			SearchBlueprint(DependentPackageMap, AssetRegistryModule, LevelScriptBlueprint);
+		}
+	}
+	SearchPlacedActors(DependentPackageMap, AssetRegistryModule, World);
+
+	FinalizeSearchResults(AssetRegistryModule, WorldPackageName);
+	return TreeView;
+}
+
+TArray<FHRFTreeViewItemPtr> FHardReferenceFinderSearchData::GatherSearchDataForAsset(UObject* Asset)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+	Reset();
+	HardReferenceSearchInternals::FSearchScratch Scratch(ScratchPackages, SearchPackages, NumScratchAllocations);
+
+	if(Asset == nullptr)
+	{
+		return TreeView;
+	}
+
+	TMap<FName, FHRFTreeViewItemPtr> DependentPackageMap;
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TArray<FName> AssetDependencies;
+	GetPackageDependencies(AssetDependencies, AssetRegistryModule, Asset->GetPackage()->GetFName());
+	AddPackageHeaders(DependentPackageMap, AssetRegistryModule, AssetDependencies);
+	AddSoftPackageHeaders(AssetRegistryModule, {Asset->GetPackage()->GetFName()});
+
+	if(UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		SearchBlueprint(DependentPackageMap, AssetRegistryModule, Blueprint);
+	}
+	else if(const UDataTable* DataTable = Cast<UDataTable>(Asset))
+	{
+		SearchDataTable(DependentPackageMap, AssetRegistryModule, DataTable);
+	}
+	else if(const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Asset))
+	{
+		SearchMaterialInstance(DependentPackageMap, AssetRegistryModule, MaterialInstance);
+	}
+	else if(const UMaterial* Material = Cast<UMaterial>(Asset))
+	{
+		SearchMaterial(DependentPackageMap, AssetRegistryModule, Material);
+	}
+	else
+	{
+		// Data assets and anything else without a dedicated scanner are searched through their properties
+		const FText Tooltip = LOCTEXT("AssetPropertyTooltip", "Property of this asset");
+		SearchObjectProperties(DependentPackageMap, AssetRegistryModule, Asset, nullptr, nullptr, NAME_None, Tooltip);
+	}
+
+	FinalizeSearchResults(AssetRegistryModule, Asset->GetPackage()->GetFName());
+	return TreeView;
+}
+
+void FHardReferenceFinderSearchData::AddPackageHeaders(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, FAssetRegistryModule& AssetRegistryModule, const TArray<FName>& PackageNames)
+{
+	TArray<FName> NewPackageNames;
+	NewPackageNames.Reserve(PackageNames.Num());
+	for(const FName& PackageName : PackageNames)
+	{
+		if(!OutPackageMap.Contains(PackageName))
+		{
+			NewPackageNames.Add(PackageName);
+		}
+	}
+
+	// Script packages have no asset, which is what keeps them out of the asset lookup below
+	if(bSourcesOnly)
+	{
+		for(const FName& PackageName : NewPackageNames)
+		{
+			if(!FPackageName::IsScriptPackage(PackageName.ToString()))
+			{
+				FHRFTreeViewItemPtr Header = MakeShared<FHRFTreeViewItem>();
 				Header->bIsHeader = true;
-				Header->PackageId = PathName;
-				Header->Tooltip = FText::FromName(PathName);
-				Header->Name = FText::FromString(FileName);
-				Header->SizeOnDisk = GatherAssetSizeByName(PathName, AssetRegistryModule);
-				Header->SlateIcon = FSlateIcon("EditorStyle", FName( *("ClassIcon." + AssetTypeName))); 
-
-				FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));	
-				if (UClass* AssetClass = AssetData.GetClass())
+				Header->PackageId = PackageName;
+				Header->Name = FText::FromName(PackageName);
+				OutPackageMap.Add(PackageName, Header);
+				TreeView.Add(Header);
+			}
+		}
+		return;
+	}
+
+	TMap<FName, FAssetData> DependencyToAssetDataMap;
+	GetAssetForPackages(NewPackageNames, DependencyToAssetDataMap);
+
+	for (auto MapIt = DependencyToAssetDataMap.CreateConstIterator(); MapIt; ++MapIt)
+	{
+		const FName& PathName = MapIt.Key();
+		if( FHRFTreeViewItemPtr Header = MakePackageHeader(PathName, MapIt.Value(), AssetRegistryModule) )
+		{
+			OutPackageMap.Add(PathName, Header);
+			TreeView.Add(Header);
+		}
+	}
+}
+
+void FHardReferenceFinderSearchData::AddSoftPackageHeaders(FAssetRegistryModule& AssetRegistryModule, const TArray<FName>& RootPackages)
+{
+	if(!bIncludeSoftReferences)
+	{
+		return;
+	}
+
+	TArray<FName> SoftPackageNames;
+	const UE::AssetRegistry::FDependencyQuery Flags(UE::AssetRegistry::EDependencyQuery::Soft);
+	for(const FName& RootPackage : RootPackages)
+	{
+		if(!RootPackage.IsNone())
+		{
+			AssetRegistryModule.GetDependencies(RootPackage, SoftPackageNames, UE::AssetRegistry::EDependencyCategory::Package, Flags);
+		}
+	}
+
+	if(SoftPackageNames.Num() == 0)
+	{
+		return;
+	}
+
+	// Soft references into the hard closure are free to resolve, their package is loaded by then anyway. The closure
+	// is walked from the registry for these roots only, the project wide dependency graph is too slow to build here.
+	TMap<FName, int64> HardClosure;
+	for(const FName& RootPackage : RootPackages)
+	{
+		if(!RootPackage.IsNone())
+		{
+			GatherClosurePackages(RootPackage, HardClosure, AssetRegistryModule);
+		}
+	}
+
+	TMap<FName, FAssetData> DependencyToAssetDataMap;
+	GetAssetForPackages(SoftPackageNames, DependencyToAssetDataMap);
+
+	for (auto MapIt = DependencyToAssetDataMap.CreateConstIterator(); MapIt; ++MapIt)
+	{
+		const FName& PathName = MapIt.Key();
+		if(RootPackages.Contains(PathName) || SoftPackageMap.Contains(PathName))
+		{
+			continue;
+		}
+
+		if( FHRFTreeViewItemPtr Header = MakePackageHeader(PathName, MapIt.Value(), AssetRegistryModule) )
+		{
+			Header->bIsSoftReference = true;
+			Header->bIsEffectivelyHard = HardClosure.Contains(PathName);
+			if(Header->bIsEffectivelyHard)
+			{
+				Header->Name = FText::Format(LOCTEXT("EffectivelyHardHeader", "{0} (Soft, already hard referenced)"), Header->Name);
+				Header->Tooltip = FText::Format(LOCTEXT("EffectivelyHardHeaderTooltip", "{0}\nSoft reference to a package the hard closure loads anyway, resolving it costs nothing extra."), FText::FromName(PathName));
+			}
+			else
+			{
+				Header->Name = FText::Format(LOCTEXT("SoftHeader", "{0} (Soft)"), Header->Name);
+				Header->Tooltip = FText::Format(LOCTEXT("SoftHeaderTooltip", "{0}\nSoft reference, this closure is loaded when the reference is resolved."), FText::FromName(PathName));
+			}
+
+			SoftPackageMap.Add(PathName, Header);
+			SoftTreeView.Add(Header);
+		}
+	}
+}
+
+FHRFTreeViewItemPtr FHardReferenceFinderSearchData::MakePackageHeader(FName PathName, const FAssetData& AssetData, FAssetRegistryModule& AssetRegistryModule) const
+{
+	FString AssetTypeName = GetAssetTypeName(AssetData);
+	FString FileName = FPaths::GetCleanFilename(PathName.ToString());
+
+	FHRFTreeViewItemPtr Header = MakeShared<FHRFTreeViewItem>();
+	Header->bIsHeader = true;
+	Header->PackageId = PathName;
+	Header->AssetClass = FName(*AssetTypeName);
+	Header->Tooltip = FText::FromName(PathName);
+	Header->Name = FText::FromString(FileName);
+	const TSharedRef<const FHRFClosureSize> ClosureSize = GatherClosureSize(PathName, AssetRegistryModule);
+	Header->SizeOnDisk = ClosureSize->TotalSize;
+	AddClosureBreakdown(*Header, *ClosureSize);
+	if(CookedRegistry.IsValid())
+	{
+		Header->Chunks = CookedRegistry->MakeChunkListString(ClosureSize->Chunks);
+	}
+	Header->SlateIcon = FSlateIcon("EditorStyle", FName( *("ClassIcon." + AssetTypeName))); 
+
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));	
+	if (UClass* AssetClass = AssetData.GetClass())
+	{
+		TWeakPtr<IAssetTypeActions> AssetTypeActions = AssetToolsModule.Get().GetAssetTypeActionsForClass(AssetData.GetClass());
+		if(AssetTypeActions.IsValid())
+		{
+			Header->IconColor = AssetTypeActions.Pin()->GetTypeColor();
+		}
+	}
+	return Header;
+}
+
+void FHardReferenceFinderSearchData::SearchBlueprint(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, UBlueprint* Blueprint) const
+{
+	// Every kind of graph, including nested sub graphs like state machines or collapsed nodes, is flattened into a
+	// single list of nodes up front so they can be scanned in one pass.
+	TArray<UEdGraph*> AllGraphs;
+	Blueprint->GetAllGraphs(AllGraphs);
+
+	TArray<const UEdGraphNode*> AllNodes;
+	for(const UEdGraph* Graph : AllGraphs)
+	{
+		if(Graph)
+		{
+			AllNodes.Append(Graph->Nodes);
+		}
+	}
+
+	SearchGraphNodes(OutPackageMap, AssetRegistryModule, AllNodes);
+	SearchFunctionReferences(OutPackageMap, AssetRegistryModule, Blueprint);
+	SearchBlueprintClassProperties(OutPackageMap, AssetRegistryModule, Blueprint);
+	SearchSimpleConstructionScript(OutPackageMap, AssetRegistryModule, Blueprint);
+
+	if(const UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(Blueprint))
+	{
+		SearchWidgetTree(OutPackageMap, AssetRegistryModule, WidgetBlueprint);
+	}
+}
+
+void FHardReferenceFinderSearchData::SearchWidgetTree(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UWidgetBlueprint* WidgetBlueprint) const
+{
+	if(WidgetBlueprint->WidgetTree == nullptr)
+	{
+		return;
+	}
+
+	const FText Tooltip = LOCTEXT("WidgetPropertyTooltip", "Property of a widget in the designer");
+	WidgetBlueprint->WidgetTree->ForEachWidget([this, &OutPackageMap, &AssetRegistryModule, &Tooltip](UWidget* Widget)
+	{
+		if(Widget == nullptr)
+		{
+			return;
+		}
+
+		const FName WidgetName = Widget->GetFName();
+
+		// Other user widgets placed in the tree reference their widget blueprint
+		if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Widget->GetClass()->GetPackage()))
+		{
+			Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("WidgetInstance", "{0} (Widget)"), WidgetName, NAME_None, Widget->GetClass());
+		}
+
+		SearchObjectProperties(OutPackageMap, AssetRegistryModule, Widget, Widget->GetArchetype(), nullptr, WidgetName, Tooltip);
+	});
+}
+
+void FHardReferenceFinderSearchData::SearchPlacedActors(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UWorld* World) const
+{
+	for(const ULevel* Level : World->GetLevels())
+	{
+		if(Level == nullptr)
+		{
+			continue;
+		}
+
+		for(AActor* Actor : Level->Actors)
+		{
+			if(Actor == nullptr)
+			{
+				continue;
+			}
+
+			// Placing an instance of a blueprint references the blueprint's package
+			if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Actor->GetClass()->GetPackage()))
+			{
+				Result->SetDeferredName(EHRFDisplayKind::PlacedActor, LOCTEXT("PlacedActor", "{0} (Placed Actor)"), NAME_None, NAME_None, Actor->GetClass());
+				Result->SourceObject = Actor;
+			}
+
+			// Only values that differ from the archetype are saved with the instance
+			const FText OverrideTooltip = LOCTEXT("ActorPropertyOverrideTooltip", "Property of a placed actor that differs from its class defaults");
+			SearchObjectProperties(OutPackageMap, AssetRegistryModule, Actor, Actor->GetArchetype(), Actor, NAME_None, OverrideTooltip);
+			for(const UActorComponent* Component : Actor->GetComponents())
+			{
+				if(Component)
 				{
-					TWeakPtr<IAssetTypeActions> AssetTypeActions = AssetToolsModule.Get().GetAssetTypeActionsForClass(AssetData.GetClass());
-					if(AssetTypeActions.IsValid())
-					{
-						Header->IconColor = AssetTypeActions.Pin()->GetTypeColor();
-					}
+					SearchObjectProperties(OutPackageMap, AssetRegistryModule, Component, Component->GetArchetype(), Actor, Component->GetFName(), OverrideTooltip);
 				}
-			
-				DependentPackageMap.Add(PathName, Header);
-				TreeView.Add(Header);
 			}
 		}
 	}
-	
+}
+
+void FHardReferenceFinderSearchData::SearchObjectProperties(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UObject* Object, const UObject* Archetype, UObject* SourceObject, FName SourceName, const FText& Tooltip, TArrayView<const FName> SkippedProperties) const
+{
+	FHRFPackageCollector& ReferencedPackages = GetScratchPackages();
+	for( const FProperty* Property : TFieldRange<FProperty>(Object->GetClass(), EFieldIteratorFlags::IncludeSuper))
 	{
-		// Search through blueprint nodes for references to the dependent packages
-		if( UBlueprint* Blueprint = BlueprintEditor.Pin()->GetBlueprintObj() )
+		// When an archetype is given only the values that differ from it are considered
+		if(Property->HasAnyPropertyFlags(CPF_Transient) || (Archetype && Property->Identical_InContainer(Object, Archetype)) || SkippedProperties.Contains(Property->GetFName()))
+		{
+			continue;
+		}
+
+		FSlateIcon ResultIcon;
+		const auto DescribeResult = [&](const FHRFTreeViewItemPtr& Result)
+		{
+			if(SourceObject && SourceObject->IsA<AActor>())
+			{
+				const FText NameFormat = SourceName.IsNone() ? LOCTEXT("ActorProperty", "{0}.{1}") : LOCTEXT("ActorComponentProperty", "{0}.{2}.{1}");
+				Result->SetDeferredName(EHRFDisplayKind::PlacedActor, NameFormat, Property->GetFName(), SourceName);
+			}
+			else if(SourceName.IsNone())
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("ObjectProperty", "{0}"), Property->GetFName());
+			}
+			else
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("ObjectPropertyPath", "{0}.{1}"), SourceName, Property->GetFName());
+			}
+			Result->Tooltip = Tooltip;
+			Result->SlateIcon = ResultIcon;
+			Result->SourceObject = SourceObject;
+		};
+
+		ReferencedPackages.Reset();
+		FindPackagesForProperty(ReferencedPackages, ResultIcon, Object, Property);
+		for(const UPackage* Package : ReferencedPackages.GetPackages())
+		{
+			if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Package))
+			{
+				DescribeResult(Result);
+			}
+		}
+
+		if(bIncludeSoftReferences)
+		{
+			ReferencedPackages.Reset();
+			FindSoftPackagesForProperty(ReferencedPackages, ResultIcon, Object, Property);
+			for(const FName& PackageName : ReferencedPackages.GetSoftPackages())
+			{
+				if(const FHRFTreeViewItemPtr Result = CheckAddSoftPackageResult(PackageName))
+				{
+					DescribeResult(Result);
+				}
+			}
+		}
+	}
+}
+
+void FHardReferenceFinderSearchData::SearchDataTable(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UDataTable* DataTable) const
+{
+	const UScriptStruct* RowStruct = DataTable->GetRowStruct();
+	if(RowStruct == nullptr)
+	{
+		return;
+	}
+
+	// User defined row structs are assets of their own
+	if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, RowStruct->GetPackage()))
+	{
+		Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("DataTableRowStruct", "{0} (Row Struct)"), RowStruct->GetFName(), NAME_None, UScriptStruct::StaticClass());
+	}
+
+	struct FRowReference
+	{
+		FName PackageName;
+		FName PropertyPath;
+		FSlateIcon Icon;
+		bool bIsSoft;
+	};
+
+	TArray<TPair<FName, const uint8*>> Rows;
+	Rows.Reserve(DataTable->GetRowMap().Num());
+	for(const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		Rows.Add(TPair<FName, const uint8*>(Row.Key, Row.Value));
+	}
+
+	// Rows are independent so large tables are walked in parallel. Each row only reads its own memory and writes its own
+	// output slot, results are attached to the tree afterwards on this thread in row order. There is one task per worker
+	// which claims batches of rows until none are left. Each worker walks with a collector of its own, kept between
+	// searches so its bitset over every object is only sized once.
+	TArray<TArray<FRowReference>> RowReferences;
+	RowReferences.SetNum(Rows.Num());
+	const int32 NumBatches = FMath::DivideAndRoundUp(Rows.Num(), HardReferenceSearchInternals::DataTableRowsPerBatch);
+	const int32 NumWorkers = FMath::Min(NumBatches, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+	while(WorkerPackages.Num() < NumWorkers)
+	{
+		WorkerPackages.Add(MakeUnique<FHRFPackageCollector>(NumScratchAllocations));
+		NumScratchAllocations.Increment();
+	}
+
+	FThreadSafeCounter NextBatch;
+	ParallelFor(NumWorkers, [this, RowStruct, &Rows, &RowReferences, &NextBatch, NumBatches](int32 WorkerIndex)
+	{
+		// Memory scopes are per thread, workers can't use the one of the search
+		LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+		FHRFPackageCollector& ReferencedPackages = *WorkerPackages[WorkerIndex];
+		TArray<TPair<const FProperty*, int32>> Path;
+
+		for(int32 BatchIndex = NextBatch.Increment() - 1; BatchIndex < NumBatches; BatchIndex = NextBatch.Increment() - 1)
+		{
+			const int32 FirstRow = BatchIndex * HardReferenceSearchInternals::DataTableRowsPerBatch;
+			const int32 LastRow = FMath::Min(FirstRow + HardReferenceSearchInternals::DataTableRowsPerBatch, Rows.Num());
+			for(int32 RowIndex = FirstRow; RowIndex < LastRow; ++RowIndex)
+			{
+				TArray<FRowReference>& References = RowReferences[RowIndex];
+				FindPackagesInStruct(ReferencedPackages, Path, RowStruct, Rows[RowIndex].Value, [&References](FName PackageName, const TArray<TPair<const FProperty*, int32>>& PropertyPath, const FSlateIcon& Icon, bool bIsSoft)
+				{
+					References.Add({PackageName, HardReferenceSearchInternals::MakePropertyPath(PropertyPath), Icon, bIsSoft});
+				});
+			}
+		}
+
+		// Kept for the next table, but not pointing at packages that may be collected by then
+		ReferencedPackages.Reset();
+	});
+
+	for(int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		for(const FRowReference& Reference : RowReferences[RowIndex])
+		{
+			const FHRFTreeViewItemPtr Result = Reference.bIsSoft ? CheckAddSoftPackageResult(Reference.PackageName) : CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Reference.PackageName);
+			if(Result.IsValid())
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("DataTableRowProperty", "{0}.{1}"), Rows[RowIndex].Key, Reference.PropertyPath);
+				Result->Tooltip = LOCTEXT("DataTableRowPropertyTooltip", "Property of a data table row");
+				Result->SlateIcon = Reference.Icon;
+			}
+		}
+	}
+}
+
+void FHardReferenceFinderSearchData::FindPackagesInStruct(FHRFPackageCollector& OutReferencedPackages, TArray<TPair<const FProperty*, int32>>& InOutPath, const UStruct* Struct, const void* ContainerPtr, TFunctionRef<void(FName PackageName, const TArray<TPair<const FProperty*, int32>>& Path, const FSlateIcon& Icon, bool bIsSoft)> OnReference) const
+{
+	for(const FProperty* Property : TFieldRange<FProperty>(Struct))
+	{
+		InOutPath.Add(TPair<const FProperty*, int32>(Property, INDEX_NONE));
+
+		FSlateIcon ResultIcon;
+		OutReferencedPackages.Reset();
+		FindPackagesForProperty(OutReferencedPackages, ResultIcon, ContainerPtr, Property);
+		for(const UPackage* Package : OutReferencedPackages.GetPackages())
+		{
+			OnReference(Package->GetFName(), InOutPath, ResultIcon, false);
+		}
+
+		if(bIncludeSoftReferences)
+		{
+			OutReferencedPackages.Reset();
+			FindSoftPackagesForProperty(OutReferencedPackages, ResultIcon, ContainerPtr, Property);
+			for(const FName& PackageName : OutReferencedPackages.GetSoftPackages())
+			{
+				OnReference(PackageName, InOutPath, ResultIcon, true);
+			}
+		}
+
+		// The calls above only see values held directly by the property, members of nested structs are walked here.
+		// Soft paths are structs too but are already handled as values.
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+		const FStructProperty* StructProperty = CastField<FStructProperty>(ArrayProperty ? ArrayProperty->Inner : Property);
+		const bool bMayReference = StructProperty && !HardReferenceSearchInternals::IsSoftValueProperty(StructProperty) && (bIncludeSoftReferences || OutReferencedPackages.ContainsStrongObjectReference(StructProperty));
+		if(bMayReference && ArrayProperty)
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(ContainerPtr));
+			for(int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+			{
+				InOutPath.Last().Value = Index;
+				FindPackagesInStruct(OutReferencedPackages, InOutPath, StructProperty->Struct, ArrayHelper.GetRawPtr(Index), OnReference);
+			}
+		}
+		else if(bMayReference)
+		{
+			FindPackagesInStruct(OutReferencedPackages, InOutPath, StructProperty->Struct, StructProperty->ContainerPtrToValuePtr<void>(ContainerPtr), OnReference);
+		}
+
+		InOutPath.Pop(false);
+	}
+}
+
+void FHardReferenceFinderSearchData::SearchMaterialInstance(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UMaterialInstance* MaterialInstance) const
+{
+	if(MaterialInstance->Parent)
+	{
+		if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, MaterialInstance->Parent->GetPackage()))
+		{
+			Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("ParentMaterial", "{0} (Parent Material)"), MaterialInstance->Parent->GetFName(), NAME_None, MaterialInstance->Parent->GetClass());
+		}
+	}
+
+	for(const FTextureParameterValue& Parameter : MaterialInstance->TextureParameterValues)
+	{
+		if(Parameter.ParameterValue)
+		{
+			if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Parameter.ParameterValue->GetPackage()))
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("TextureParameter", "{0} (Texture Parameter)"), Parameter.ParameterInfo.Name, NAME_None, Parameter.ParameterValue->GetClass());
+			}
+		}
+	}
+
+	for(const FFontParameterValue& Parameter : MaterialInstance->FontParameterValues)
+	{
+		if(Parameter.FontValue)
+		{
+			if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Parameter.FontValue->GetPackage()))
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("FontParameter", "{0} (Font Parameter)"), Parameter.ParameterInfo.Name, NAME_None, Parameter.FontValue->GetClass());
+			}
+		}
+	}
+
+	// Anything else, e.g. physical materials or subsurface profiles, comes from regular properties. The parent and
+	// parameters were attributed above and would otherwise be listed a second time as raw properties.
+	static const FName AttributedProperties[] =
+	{
+		GET_MEMBER_NAME_CHECKED(UMaterialInstance, Parent),
+		GET_MEMBER_NAME_CHECKED(UMaterialInstance, TextureParameterValues),
+		GET_MEMBER_NAME_CHECKED(UMaterialInstance, FontParameterValues),
+	};
+	const FText Tooltip = LOCTEXT("MaterialPropertyTooltip", "Property of this material");
+	SearchObjectProperties(OutPackageMap, AssetRegistryModule, MaterialInstance, nullptr, nullptr, NAME_None, Tooltip, AttributedProperties);
+}
+
+void FHardReferenceFinderSearchData::SearchMaterial(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UMaterial* Material) const
+{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	const TArray<UMaterialExpression*>& Expressions = Material->Expressions;
+#else
+	const TConstArrayView<TObjectPtr<UMaterialExpression>> Expressions = Material->GetExpressions();
+#endif
+
+	// Texture samples, material functions, etc. hold their references in properties of the expression
+	const FText ExpressionTooltip = LOCTEXT("MaterialExpressionTooltip", "Material graph expression");
+	for(const UMaterialExpression* Expression : Expressions)
+	{
+		if(Expression)
+		{
+			SearchObjectProperties(OutPackageMap, AssetRegistryModule, Expression, nullptr, nullptr, Expression->GetFName(), ExpressionTooltip);
+		}
+	}
+
+	const FText Tooltip = LOCTEXT("MaterialPropertyTooltip", "Property of this material");
+	SearchObjectProperties(OutPackageMap, AssetRegistryModule, Material, nullptr, nullptr, NAME_None, Tooltip);
+}
+
+void FHardReferenceFinderSearchData::SearchWorldPartitionActors(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, FAssetRegistryModule& AssetRegistryModule, UWorld* World)
+{
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	UWorldPartition* WorldPartition = World->GetWorldPartition();
+	if(WorldPartition == nullptr)
+	{
+		return;
+	}
+
+	struct FUnloadedActor
+	{
+		FName PackageName;
+		FName Label;
+	};
+
+	// Only the registry is queried for actors that aren't loaded, so nothing is loaded to scan them
+	TArray<FUnloadedActor> UnloadedActors;
+	FWorldPartitionHelpers::ForEachActorDesc(WorldPartition, AActor::StaticClass(), [&UnloadedActors](const FWorldPartitionActorDesc* ActorDesc)
+	{
+		// Loaded actors are scanned for overrides along with the rest of the level
+		if(!ActorDesc->IsLoaded())
+		{
+			UnloadedActors.Add({ActorDesc->GetActorPackage(), ActorDesc->GetActorLabel()});
+		}
+		return true;
+	});
+
+	const FName WorldPackageName = World->GetPackage()->GetFName();
+	FScopedSlowTask SlowTask(UnloadedActors.Num(), LOCTEXT("ScanningWorldPartition", "Scanning unloaded World Partition actors for hard references..."));
+	SlowTask.MakeDialogDelayed(1.f, true);
+
+	TArray<FName> ActorDependencies;
+	for(const FUnloadedActor& Actor : UnloadedActors)
+	{
+		SlowTask.EnterProgressFrame();
+		if(SlowTask.ShouldCancel())
+		{
+			break;
+		}
+
+		ActorDependencies.Reset();
+		GetPackageDependencies(ActorDependencies, AssetRegistryModule, Actor.PackageName);
+		ActorDependencies.Remove(WorldPackageName);
+		AddPackageHeaders(OutPackageMap, AssetRegistryModule, ActorDependencies);
+
+		// Without loading the actor the best attribution available is the actor itself
+		for(const FName& Dependency : ActorDependencies)
+		{
+			if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Dependency))
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("UnloadedActor", "{0} (Unloaded Actor)"), Actor.Label);
+				Result->Tooltip = LOCTEXT("UnloadedActorTooltip", "World Partition actor that isn't loaded, load it to see which property makes the reference.");
+				Result->SlateIcon = FSlateIcon("EditorStyle", "ClassIcon.Actor");
+			}
+		}
+	}
+#endif
+}
+
+void FHardReferenceFinderSearchData::FinalizeSearchResults(FAssetRegistryModule& AssetRegistryModule, FName SearchedPackage)
+{
+	const auto FinalizeHeaders = [](TArray<FHRFTreeViewItemPtr>& Headers)
+	{
+		// If we didn't discover any references to a package make a note
+		for(FHRFTreeViewItemPtr HeaderItem : Headers)
+		{
+			if(HeaderItem->Children.Num() <= 0)
+			{
+				FHRFTreeViewItemPtr ChildItem = MakeShared<FHRFTreeViewItem>();
+				HeaderItem->Children.Add(ChildItem);
+				ChildItem->bIsSoftReference = HeaderItem->bIsSoftReference;
+				ChildItem->bIsUnidentifiedSource = true;
+				ChildItem->Name = LOCTEXT("UnknownSource", "Unidentified source");
+				ChildItem->Tooltip = LOCTEXT("UnknownSourceTooltip", "This package is being referenced but the plugin is unable to identify its source.");
+			}
+		}
+
+		// sort from largest to smallest
+		Headers.Sort([](FHRFTreeViewItemPtr Lhs, FHRFTreeViewItemPtr Rhs)
+		{
+			return Lhs->SizeOnDisk > Rhs->SizeOnDisk;
+		});
+	};
+	FinalizeHeaders(TreeView);
+	FinalizeHeaders(SoftTreeView);
+	NumPackagesReferenced = TreeView.Num();
+	NumSoftPackagesReferenced = SoftTreeView.Num();
+
+	// Soft references go after every hard reference, they only cost anything once they're resolved
+	TreeView.Append(SoftTreeView);
+
+	// The searched asset's own closure goes first, it has no package id so it isn't mistaken for a reference
+	if(!SearchedPackage.IsNone() && !bSourcesOnly)
+	{
+		const TSharedRef<const FHRFClosureSize> ClosureSize = GatherClosureSize(SearchedPackage, AssetRegistryModule);
+		SearchedClosure = ClosureSize;
+		FHRFTreeViewItemPtr TotalHeader = MakeShared<FHRFTreeViewItem>();
+		TotalHeader->bIsHeader = true;
+		TotalHeader->Name = LOCTEXT("TotalClosure", "Total hard reference closure");
+		TotalHeader->Tooltip = LOCTEXT("TotalClosureTooltip", "Everything that is loaded along with this asset, including the asset itself");
+		TotalHeader->SizeOnDisk = ClosureSize->TotalSize;
+		TotalHeader->SlateIcon = FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer");
+		AddClosureBreakdown(*TotalHeader, *ClosureSize);
+		if(CookedRegistry.IsValid())
+		{
+			TotalHeader->Chunks = CookedRegistry->MakeChunkListString(ClosureSize->Chunks);
+			if(const FHRFChunkSet* OwnChunks = CookedRegistry->FindChunks(SearchedPackage))
+			{
+				OwnChunkList = CookedRegistry->MakeChunkListString(*OwnChunks);
+			}
+			ForeignChunkSize = ClosureSize->ForeignChunkSize;
+		}
+		TreeView.Insert(TotalHeader, 0);
+	}
+}
+
+void FHardReferenceFinderSearchData::AddClosureBreakdown(FHRFTreeViewItem& OutHeader, const FHRFClosureSize& ClosureSize) const
+{
+	const auto AddGroup = [&OutHeader, &ClosureSize](const FText& GroupName, const TMap<FName, int64>& Sizes)
+	{
+		FHRFTreeViewItemPtr Group = MakeShared<FHRFTreeViewItem>();
+		Group->Name = GroupName;
+		Group->SlateIcon = FSlateIcon("EditorStyle", "ContentBrowser.SizeMap");
+
+		TArray<TPair<FName, int64>> SortedSizes = Sizes.Array();
+		SortedSizes.Sort([](const TPair<FName, int64>& Lhs, const TPair<FName, int64>& Rhs)
 		{
-			SearchGraphNodes(DependentPackageMap, AssetRegistryModule, Blueprint->UbergraphPages);
-			SearchFunctionReferences(DependentPackageMap, AssetRegistryModule, Blueprint);
-			SearchBlueprintClassProperties(DependentPackageMap, AssetRegistryModule, Blueprint);
-			SearchSimpleConstructionScript(DependentPackageMap, AssetRegistryModule, Blueprint);
-		}
-	}
+			return Lhs.Value > Rhs.Value;
+		});
 
-	// If we didn't discover any references to a package make a note
-	for(FHRFTreeViewItemPtr HeaderItem : TreeView)
-	{
-		if(HeaderItem->Children.Num() <= 0)
+		for(const TPair<FName, int64>& Size : SortedSizes)
 		{
-			FHRFTreeViewItemPtr ChildItem = MakeShared<FHRFTreeViewItem>();
-			HeaderItem->Children.Add(ChildItem);
-			ChildItem->Name = LOCTEXT("UnknownSource", "Unidentified source");
-			ChildItem->Tooltip = LOCTEXT("UnknownSourceTooltip", "This package is being referenced but the plugin is unable to identify its source.");
+			const double Fraction = ClosureSize.TotalSize > 0 ? static_cast<double>(Size.Value) / ClosureSize.TotalSize : 0.0;
+			FHRFTreeViewItemPtr Entry = MakeShared<FHRFTreeViewItem>();
+			Entry->Name = FText::Format(LOCTEXT("ClosureBreakdownEntry", "{0}: {1} ({2})"), FText::FromName(Size.Key), FText::AsPercent(Fraction), HardReferenceInternals::MakeBestSizeString(Size.Value));
+			Group->Children.Add(Entry);
 		}
-	}
-	
-	// sort from largest to smallest
-	TreeView.Sort([](FHRFTreeViewItemPtr Lhs, FHRFTreeViewItemPtr Rhs)
+		OutHeader.Breakdown.Add(Group);
+	};
+
+	if(ClosureSize.TotalSize > 0)
 	{
-		return Lhs->SizeOnDisk > Rhs->SizeOnDisk;
-	});
-	
-	return TreeView;
+		AddGroup(LOCTEXT("BreakdownByClass", "Size by asset class"), ClosureSize.SizeByClass);
+		AddGroup(LOCTEXT("BreakdownByFolder", "Size by folder"), ClosureSize.SizeByFolder);
+	}
 }
 
 void FHardReferenceFinderSearchData::Reset()
 {
 	TreeView.Reset();
+	NumPackagesReferenced = 0;
+	SoftPackageMap.Reset();
+	SoftTreeView.Reset();
+	NumSoftPackagesReferenced = 0;
+	OwnChunkList.Reset();
+	ForeignChunkSize = 0;
+	SearchedClosure.Reset();
+	NumScratchAllocations.Reset();
+
+	// Loaded once per platform and shared by every search, so switching platforms doesn't read the registry again
+	CookedRegistry.Reset();
+	if(!SizePlatform.IsNone())
+	{
+		CookedRegistry = FHardReferenceFinderCache::Get().FindOrLoadCookedRegistry(SizePlatform);
+	}
 }
 
 UObject* FHardReferenceFinderSearchData::GetObjectContext(TWeakPtr<FBlueprintEditor> BlueprintEditor) const
@@ -130,76 +1118,45 @@ void FHardReferenceFinderSearchData::GetBlueprintDependencies(TArray<FName>& Out
 	}
 	
 	FAssetData ExistingAsset = GetAssetDataForObject(Object);
+	GetPackageDependencies(OutPackageDependencies, AssetRegistryModule, ExistingAsset.PackageName);
+}
 
+void FHardReferenceFinderSearchData::GetPackageDependencies(TArray<FName>& OutPackageDependencies, FAssetRegistryModule& AssetRegistryModule, FName PackageName) const
+{
 	UE::AssetRegistry::FDependencyQuery Flags(UE::AssetRegistry::EDependencyQuery::Hard);
-	AssetRegistryModule.GetDependencies(ExistingAsset.PackageName, OutPackageDependencies, UE::AssetRegistry::EDependencyCategory::Package, Flags);
+	AssetRegistryModule.GetDependencies(PackageName, OutPackageDependencies, UE::AssetRegistry::EDependencyCategory::Package, Flags);
 }
 
-void FHardReferenceFinderSearchData::SearchGraphNodes(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const FEdGraphArray& EdGraphList) const
+void FHardReferenceFinderSearchData::SearchGraphNodes(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const TArray<const UEdGraphNode*>& Nodes) const
 {
-	for(UEdGraph* Graph : EdGraphList)
+	// Nodes are split into batches that are scanned in parallel. Workers only read the nodes and record plain data
+	// into the buffer of their own batch, the results are then attached to the tree on this thread in node order.
+	const int32 NumBatches = FMath::DivideAndRoundUp(Nodes.Num(), HardReferenceSearchInternals::GraphNodesPerBatch);
+	TArray<TArray<HardReferenceSearchInternals::FGraphNodeReference>> BatchReferences;
+	BatchReferences.SetNum(NumBatches);
+	ParallelFor(NumBatches, [&Nodes, &BatchReferences](int32 BatchIndex)
 	{
-		if(Graph)
+		LLM_SCOPE_BYTAG(HardReferenceFinder_Search);
+		const int32 FirstNode = BatchIndex * HardReferenceSearchInternals::GraphNodesPerBatch;
+		const int32 LastNode = FMath::Min(FirstNode + HardReferenceSearchInternals::GraphNodesPerBatch, Nodes.Num());
+		for(int32 NodeIndex = FirstNode; NodeIndex < LastNode; ++NodeIndex)
 		{
-			for (UEdGraphNode* Node : Graph->Nodes)
-			{
-				const UPackage* FunctionPackage = nullptr;
-				if(const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
-				{
-					FunctionPackage = CallFunctionNode->FunctionReference.GetMemberParentPackage();
-				}
-				else if(const UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
-				{
-					if(CastNode->TargetType)
-					{
-						FunctionPackage = CastNode->TargetType->GetPackage();
-					}
-				}
-
-				if( const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, FunctionPackage) )
-				{
-					Result->Name = Node->GetNodeTitle(ENodeTitleType::ListView);
-					Result->NodeGuid = Node->NodeGuid;
-					Result->SlateIcon = Node->GetIconAndTint(Result->IconColor);
-				}
-
-				// Also search the pins of this node for any references to other packages, e.g. the 'Class' pin of a SpawnActor node.
-				SearchNodePins(OutPackageMap, AssetRegistryModule, Node);
-			}
+			HardReferenceSearchInternals::GatherNodeReferences(BatchReferences[BatchIndex], Nodes[NodeIndex], NodeIndex);
 		}
-	}
-}
+	});
 
-void FHardReferenceFinderSearchData::SearchNodePins(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UEdGraphNode* Node) const
-{
-	if(Node == nullptr)
-	{
-		return;
-	}
-	
-	for(const UEdGraphPin* Pin : Node->Pins)
+	for(const TArray<HardReferenceSearchInternals::FGraphNodeReference>& References : BatchReferences)
 	{
-		if(Pin->bHidden)
-		{
-			// skip hidden pins
-			continue;
-		}
-					
-		if(Pin->Direction == EGPD_Input)
+		for(const HardReferenceSearchInternals::FGraphNodeReference& Reference : References)
 		{
-			if(const UObject* PinObject = Pin->DefaultObject)
+			const FHRFTreeViewItemPtr Result = Reference.bIsSoft ? CheckAddSoftPackageResult(Reference.PackageName) : CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Reference.PackageName);
+			if( Result.IsValid() )
 			{
-				const UPackage* FunctionPackage = PinObject->GetPackage();
-				if( const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, FunctionPackage) )
-				{
-					Result->Name = FText::Format(LOCTEXT("FunctionInput","{0} ({1})"), FText::FromString(Pin->GetName()), Node->GetNodeTitle(ENodeTitleType::ListView));
-					Result->NodeGuid = Node->NodeGuid;
-					if( const UEdGraphSchema* Schema = Pin->GetSchema() )
-					{
-						Result->IconColor = Schema->GetPinTypeColor(Pin->PinType);
-					}
-					Result->SlateIcon = FSlateIcon("EditorStyle", "Graph.Pin.Disconnected_VarA");
-				}
+				const UEdGraphNode* Node = Nodes[Reference.NodeIndex];
+				Result->NodeGuid = Node->NodeGuid;
+				Result->SourceNode = Node;
+				Result->SourceName = Reference.PinName;
+				Result->DisplayKind = Reference.PinName.IsNone() ? EHRFDisplayKind::GraphNode : EHRFDisplayKind::GraphPin;
 			}
 		}
 	}
@@ -222,8 +1179,8 @@ void FHardReferenceFinderSearchData::SearchFunctionReferences(TMap<FName, FHRFTr
 	//
 	// Note that neither method identifies all type 3 references so this approach may need to be amended/revised
 
-	// This gathers type 1/3c references and creates links to the associated graph nodes.
-	SearchGraphNodes(OutPackageMap, AssetRegistryModule, Blueprint->FunctionGraphs);
+	// Type 1/3c references are gathered along with every other graph node by SearchGraphNodes() and linked to the
+	// associated graph nodes.
 
 	// This gathers type 2 references and links them to the function entry node
 	for( UFunction* Function : TFieldRange<UFunction>(Blueprint->GeneratedClass, EFieldIteratorFlags::ExcludeSuper) )
@@ -236,9 +1193,9 @@ void FHardReferenceFinderSearchData::SearchFunctionReferences(TMap<FName, FHRFTr
 				const UPackage* Package = ReferencedObject->GetPackage();
 				if( const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Package) )
 				{
-					Result->Name = FText::Format(LOCTEXT("FunctionReference","{0}"), GraphEntryNode->GetNodeTitle(ENodeTitleType::ListView));
 					Result->NodeGuid = GraphEntryNode->NodeGuid;
-					Result->SlateIcon = GraphEntryNode->GetIconAndTint(Result->IconColor);
+					Result->SourceNode = GraphEntryNode;
+					Result->DisplayKind = EHRFDisplayKind::GraphNode;
 				}
 			}
 		}
@@ -253,6 +1210,7 @@ void FHardReferenceFinderSearchData::SearchSimpleConstructionScript(TMap<FName,
 		return;
 	}
 	
+	FHRFPackageCollector& ReferencedPackages = GetScratchPackages();
 	const TArray<USCS_Node*>& RootNodes = SimpleConstructionScript->GetAllNodes();
 	for(const USCS_Node* SCSNode : RootNodes)
 	{
@@ -263,16 +1221,26 @@ void FHardReferenceFinderSearchData::SearchSimpleConstructionScript(TMap<FName,
 
 		const FName VarName = SCSNode->GetVariableName();
 		
-		TSet<UPackage*> OutReferencedPackages;
-		FindPackagesInSCSNode(OutReferencedPackages, SCSNode);
+		ReferencedPackages.Reset();
+		FindPackagesInSCSNode(ReferencedPackages, SCSNode);
 
-		for(const UPackage* Package : OutReferencedPackages)
+		const auto DescribeResult = [SCSNode, VarName](const FHRFTreeViewItemPtr& Result)
+		{
+			Result->SetDeferredName(EHRFDisplayKind::Component, LOCTEXT("ComponentReference", "{0}"), VarName, NAME_None, SCSNode->ComponentClass);
+			Result->SCSIdentifier = SCSNode->GetFName();
+		};
+		for(const UPackage* Package : ReferencedPackages.GetPackages())
 		{
 			if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Package))
 			{
-				Result->SlateIcon = FSlateIconFinder::FindIconForClass(SCSNode->ComponentClass, TEXT("SCS.Component"));
-				Result->Name = FText::Format(LOCTEXT("ComponentReference", "{0}"), FText::FromName(VarName));
-				Result->SCSIdentifier = SCSNode->GetFName();
+				DescribeResult(Result);
+			}
+		}
+		for(const FName& PackageName : ReferencedPackages.GetSoftPackages())
+		{
+			if(const FHRFTreeViewItemPtr Result = CheckAddSoftPackageResult(PackageName))
+			{
+				DescribeResult(Result);
 			}
 		}
 	}
@@ -326,7 +1294,7 @@ UK2Node_FunctionEntry* FHardReferenceFinderSearchData::FindGraphNodeForFunction(
 	return nullptr;
 }
 
-void FHardReferenceFinderSearchData::FindPackagesInSCSNode(TSet<UPackage*>& OutReferencedPackages, const USCS_Node* SCSNode) const
+void FHardReferenceFinderSearchData::FindPackagesInSCSNode(FHRFPackageCollector& OutReferencedPackages, const USCS_Node* SCSNode) const
 {
 	if(SCSNode==nullptr || SCSNode->ComponentClass == nullptr)
 	{
@@ -344,87 +1312,73 @@ void FHardReferenceFinderSearchData::FindPackagesInSCSNode(TSet<UPackage*>& OutR
 	for( const FProperty* Property : TFieldRange<FProperty>(SCSNode->ComponentClass, EFieldIteratorFlags::IncludeSuper))
 	{
 		FSlateIcon VariableTypeIcon;
-		TArray<UPackage*> ReferencedPackages = FindPackagesForProperty(VariableTypeIcon, SCSNode->ComponentTemplate, Property );
-		for(UPackage* Package : ReferencedPackages)
+		FindPackagesForProperty(OutReferencedPackages, VariableTypeIcon, SCSNode->ComponentTemplate, Property);
+		if(bIncludeSoftReferences)
 		{
-			OutReferencedPackages.Add(Package);
+			FindSoftPackagesForProperty(OutReferencedPackages, VariableTypeIcon, SCSNode->ComponentTemplate, Property);
 		}
 	}
 }
 
-TArray<UPackage*> FHardReferenceFinderSearchData::FindPackagesForProperty(FSlateIcon& OutResultIcon, const UObject* ContainerPtr, const FProperty* TargetProperty) const
+void FHardReferenceFinderSearchData::FindPackagesForProperty(FHRFPackageCollector& OutReferencedPackages, FSlateIcon& OutResultIcon, const void* ContainerPtr, const FProperty* TargetProperty) const
 {
-	TArray<UPackage*> FoundPackages;
-
 	if(TargetProperty == nullptr)
 	{
-		return FoundPackages;
+		return;
 	}
 	
-	if(ContainerPtr != nullptr)
+	if(ContainerPtr != nullptr && OutReferencedPackages.ContainsStrongObjectReference(TargetProperty))
 	{
-		TArray<const FStructProperty*> EncounteredStructProps;
-		const EPropertyObjectReferenceType ReferenceType = EPropertyObjectReferenceType::Strong;
-		const bool bHasStrongReferences = TargetProperty->ContainsObjectReference(EncounteredStructProps, ReferenceType);
-		if(bHasStrongReferences)
-		{
-			const void* TargetPropertyAddress = TargetProperty->ContainerPtrToValuePtr<void>(ContainerPtr);
-
-			struct PropertyAndAddressTuple
-			{
-				const FProperty* Property = nullptr;
-				const void* ValueAddress = nullptr;
-			};
-			TArray<PropertyAndAddressTuple> PropertiesToExamine;
+		const void* TargetPropertyAddress = TargetProperty->ContainerPtrToValuePtr<void>(ContainerPtr);
 
-			if(const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(TargetProperty))
-			{
-				OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.ArrayTypeIcon");
-				FScriptArrayHelper ArrayHelper(ArrayProperty, TargetPropertyAddress);
-				for(int i=0; i<ArrayHelper.Num(); ++i)
-				{
-					PropertiesToExamine.Add({ArrayProperty->Inner, ArrayHelper.GetRawPtr(i)});
-				}
-			}
-			else if(const FSetProperty* SetProperty = CastField<FSetProperty>(TargetProperty))
+		// Values are examined in place, so walking a container doesn't copy its elements anywhere first
+		auto AddValuePackage = [&OutReferencedPackages](const FProperty* Property, const void* ValueAddress)
+		{
+			if( const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property) )
 			{
-				OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.SetTypeIcon");
-				FScriptSetHelper SetHelper(SetProperty, TargetPropertyAddress);
-				for(int i=0; i<SetHelper.Num(); ++i)
+				if(const UObject* Object = ObjectProperty->GetObjectPropertyValue(ValueAddress))
 				{
-					PropertiesToExamine.Add({SetHelper.GetElementProperty(), SetHelper.GetElementPtr(i)});
+					if(UPackage* Package = Object->GetPackage())
+					{
+						OutReferencedPackages.Add(Package);
+					}
 				}
 			}
-			else if(const FMapProperty* MapProperty = CastField<FMapProperty>(TargetProperty))
+		};
+
+		if(const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(TargetProperty))
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.ArrayTypeIcon");
+			FScriptArrayHelper ArrayHelper(ArrayProperty, TargetPropertyAddress);
+			for(int i=0; i<ArrayHelper.Num(); ++i)
 			{
-				OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.MapValueTypeIcon");
-				FScriptMapHelper MapHelper(MapProperty, TargetPropertyAddress);
-				for(int i=0; i<MapHelper.Num(); ++i)
-				{
-					PropertiesToExamine.Add({MapHelper.GetKeyProperty(), MapHelper.GetKeyPtr(i)});
-					PropertiesToExamine.Add({MapHelper.GetValueProperty(), MapHelper.GetValuePtr(i)});
-				}
+				AddValuePackage(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
 			}
-			else
+		}
+		else if(const FSetProperty* SetProperty = CastField<FSetProperty>(TargetProperty))
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.SetTypeIcon");
+			FScriptSetHelper SetHelper(SetProperty, TargetPropertyAddress);
+			for(int i=0; i<SetHelper.Num(); ++i)
 			{
-				OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.TypeIcon");
-				PropertiesToExamine.Add({TargetProperty, TargetPropertyAddress});
+				AddValuePackage(SetHelper.GetElementProperty(), SetHelper.GetElementPtr(i));
 			}
-
-			for (const PropertyAndAddressTuple& Tuple : PropertiesToExamine)
+		}
+		else if(const FMapProperty* MapProperty = CastField<FMapProperty>(TargetProperty))
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.MapValueTypeIcon");
+			FScriptMapHelper MapHelper(MapProperty, TargetPropertyAddress);
+			for(int i=0; i<MapHelper.Num(); ++i)
 			{
-				if( const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Tuple.Property) )
-				{
-					if(const UObject* Object = ObjectProperty->GetObjectPropertyValue(Tuple.ValueAddress))
-					{
-						if(UPackage* Package = Object->GetPackage())
-						{
-							FoundPackages.AddUnique(Package);
-						}
-					}
-				}
+				AddValuePackage(MapHelper.GetKeyProperty(), MapHelper.GetKeyPtr(i));
+				AddValuePackage(MapHelper.GetValueProperty(), MapHelper.GetValuePtr(i));
 			}
 		}
+		else
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.TypeIcon");
+			AddValuePackage(TargetProperty, TargetPropertyAddress);
+		}
 	}
 
 #if UE_VERSION_OLDER_THAN(5,3,0)
@@ -440,7 +1394,7 @@ TArray<UPackage*> FHardReferenceFinderSearchData::FindPackagesForProperty(FSlate
 		{
 			if(UPackage* Package = ObjectProperty->PropertyClass->GetPackage())
 			{
-				FoundPackages.AddUnique(Package);
+				OutReferencedPackages.Add(Package);
 			}
 		}
 	}
@@ -457,22 +1411,268 @@ TArray<UPackage*> FHardReferenceFinderSearchData::FindPackagesForProperty(FSlate
 			{
 				if(UPackage* Package = ObjectReference->GetPackage())
 				{
-					FoundPackages.AddUnique(Package);
+					OutReferencedPackages.Add(Package);
 				}
 			}
 		}
 	}
-	
-	return FoundPackages;
+}
+
+void FHardReferenceFinderSearchData::FindSoftPackagesForProperty(FHRFPackageCollector& OutReferencedPackages, FSlateIcon& OutResultIcon, const void* ContainerPtr, const FProperty* TargetProperty) const
+{
+	if(TargetProperty == nullptr || ContainerPtr == nullptr)
+	{
+		return;
+	}
+
+	// Like FindPackagesForProperty, only the property itself and the elements of a container are inspected
+	const void* TargetPropertyAddress = TargetProperty->ContainerPtrToValuePtr<void>(ContainerPtr);
+	auto AddValuePackage = [&OutReferencedPackages](const FProperty* Property, const void* ValueAddress)
+	{
+		const FName PackageName = HardReferenceSearchInternals::GetSoftValuePackage(Property, ValueAddress);
+		if(!PackageName.IsNone())
+		{
+			OutReferencedPackages.AddSoft(PackageName);
+		}
+	};
+
+	if(const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(TargetProperty))
+	{
+		if(HardReferenceSearchInternals::IsSoftValueProperty(ArrayProperty->Inner))
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.ArrayTypeIcon");
+			FScriptArrayHelper ArrayHelper(ArrayProperty, TargetPropertyAddress);
+			for(int i=0; i<ArrayHelper.Num(); ++i)
+			{
+				AddValuePackage(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
+			}
+		}
+	}
+	else if(const FSetProperty* SetProperty = CastField<FSetProperty>(TargetProperty))
+	{
+		if(HardReferenceSearchInternals::IsSoftValueProperty(SetProperty->ElementProp))
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.SetTypeIcon");
+			FScriptSetHelper SetHelper(SetProperty, TargetPropertyAddress);
+			for(int i=0; i<SetHelper.Num(); ++i)
+			{
+				AddValuePackage(SetHelper.GetElementProperty(), SetHelper.GetElementPtr(i));
+			}
+		}
+	}
+	else if(const FMapProperty* MapProperty = CastField<FMapProperty>(TargetProperty))
+	{
+		const bool bIsSoftKey = HardReferenceSearchInternals::IsSoftValueProperty(MapProperty->KeyProp);
+		const bool bIsSoftValue = HardReferenceSearchInternals::IsSoftValueProperty(MapProperty->ValueProp);
+		if(bIsSoftKey || bIsSoftValue)
+		{
+			OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.MapValueTypeIcon");
+			FScriptMapHelper MapHelper(MapProperty, TargetPropertyAddress);
+			for(int i=0; i<MapHelper.Num(); ++i)
+			{
+				if(bIsSoftKey)
+				{
+					AddValuePackage(MapHelper.GetKeyProperty(), MapHelper.GetKeyPtr(i));
+				}
+				if(bIsSoftValue)
+				{
+					AddValuePackage(MapHelper.GetValueProperty(), MapHelper.GetValuePtr(i));
+				}
+			}
+		}
+	}
+	else if(HardReferenceSearchInternals::IsSoftValueProperty(TargetProperty))
+	{
+		OutResultIcon = FSlateIcon("EditorStyle", "Kismet.VariableList.TypeIcon");
+		AddValuePackage(TargetProperty, TargetPropertyAddress);
+	}
+}
+
+FHRFPackageCollector& FHardReferenceFinderSearchData::GetScratchPackages() const
+{
+	check(ScratchPackages);
+	return *ScratchPackages;
+}
+
+void FHRFPackageCollector::Add(UPackage* Package)
+{
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Package);
+	if(ObjectIndex >= SeenPackages.Num())
+	{
+		// Sized for every object on first use with room for objects created later, so it rarely grows after that
+		const int32 NumObjects = FMath::Max(ObjectIndex + 1, GUObjectArray.GetObjectArrayNum());
+		const SIZE_T PreviousSize = SeenPackages.GetAllocatedSize();
+		SeenPackages.Add(false, NumObjects + NumObjects / 8 - SeenPackages.Num());
+		if(SeenPackages.GetAllocatedSize() != PreviousSize)
+		{
+			NumAllocations.Increment();
+		}
+	}
+
+	if(!SeenPackages[ObjectIndex])
+	{
+		SeenPackages[ObjectIndex] = true;
+		if(Packages.Num() == Packages.Max())
+		{
+			NumAllocations.Increment();
+		}
+		Packages.Add(Package);
+	}
+}
+
+void FHRFPackageCollector::AddSoft(FName PackageName)
+{
+	const SIZE_T PreviousSize = SeenSoftPackages.GetAllocatedSize();
+	bool bAlreadySeen = false;
+	SeenSoftPackages.Add(PackageName, &bAlreadySeen);
+	if(SeenSoftPackages.GetAllocatedSize() != PreviousSize)
+	{
+		NumAllocations.Increment();
+	}
+
+	if(!bAlreadySeen)
+	{
+		if(SoftPackages.Num() == SoftPackages.Max())
+		{
+			NumAllocations.Increment();
+		}
+		SoftPackages.Add(PackageName);
+	}
+}
+
+void FHRFPackageCollector::Reset()
+{
+	// Only the bits that were set are cleared, the bitset spans every object so clearing it all would dominate small walks
+	for(const UPackage* Package : Packages)
+	{
+		SeenPackages[GUObjectArray.ObjectToIndex(Package)] = false;
+	}
+	Packages.Reset();
+	SoftPackages.Reset();
+	SeenSoftPackages.Reset();
+}
+
+bool FHRFPackageCollector::ContainsStrongObjectReference(const FProperty* Property)
+{
+	const int32 PreviousMax = EncounteredStructProps.Max();
+	EncounteredStructProps.Reset();
+	const bool bContainsReference = Property->ContainsObjectReference(EncounteredStructProps, EPropertyObjectReferenceType::Strong);
+	if(EncounteredStructProps.Max() != PreviousMax)
+	{
+		NumAllocations.Increment();
+	}
+	return bContainsReference;
 }
 
 void FHardReferenceFinderSearchData::SearchBlueprintClassProperties(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap,	const FAssetRegistryModule& AssetRegistryModule, UBlueprint* Blueprint) const
 {
-	for( FProperty* Property : TFieldRange<FProperty>(Blueprint->GeneratedClass, EFieldIteratorFlags::ExcludeSuper))
+	if(Blueprint->GeneratedClass == nullptr)
+	{
+		return;
+	}
+
+	// Walk from this class up through its blueprint ancestors. Each class is analyzed once and the result is shared
+	// with every other child of that class, so the cost of a hierarchy scales with its number of unique classes.
+	TSet<FName> OverriddenProperties;
+	for(const UClass* Class = Blueprint->GeneratedClass; Cast<UBlueprintGeneratedClass>(Class) != nullptr; Class = Class->GetSuperClass())
+	{
+		const bool bIsInherited = Class != Blueprint->GeneratedClass;
+		const TSharedRef<const FHRFClassAnalysis> Analysis = FHardReferenceFinderCache::Get().FindOrAddClassAnalysis(Class, [this, Class](FHRFClassAnalysis& OutAnalysis)
+		{
+			AnalyzeClassProperties(OutAnalysis, Class);
+		});
+
+		for(const FHRFPropertyReference& Reference : Analysis->PropertyReferences)
+		{
+			// A class further down the hierarchy replaced this default, its value is the one that is referenced
+			if(OverriddenProperties.Contains(Reference.PropertyName))
+			{
+				continue;
+			}
+
+			const FHRFTreeViewItemPtr Result = Reference.bIsSoft ? CheckAddSoftPackageResult(Reference.PackageName) : CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Reference.PackageName);
+			if(!Result.IsValid())
+			{
+				continue;
+			}
+
+			const UClass* DeclaringClass = Reference.DeclaringClass.Get();
+			UBlueprint* DeclaringBlueprint = DeclaringClass ? UBlueprint::GetBlueprintFromClass(DeclaringClass) : nullptr;
+
+			UBlueprint* FoundBlueprint = nullptr;
+			const int32 VarIndex = DeclaringBlueprint ? FBlueprintEditorUtils::FindNewVariableIndexAndBlueprint(DeclaringBlueprint, Reference.PropertyName, FoundBlueprint) : INDEX_NONE;
+			const bool bIsVar = VarIndex != INDEX_NONE && FoundBlueprint != nullptr;
+
+			// The variable's type color is only looked up once the row is displayed
+			Result->SlateIcon = Reference.Icon;
+			if(bIsInherited)
+			{
+				// The default comes from an ancestor, attribute it to the class whose defaults hold the value
+				const UBlueprint* AncestorBlueprint = UBlueprint::GetBlueprintFromClass(Class);
+				const FName AncestorName = AncestorBlueprint ? AncestorBlueprint->GetFName() : Class->GetFName();
+				Result->SetDeferredName(EHRFDisplayKind::Variable, LOCTEXT("InheritedVariable","{0} (Inherited from {1})"), Reference.PropertyName, AncestorName, DeclaringClass);
+				Result->Tooltip = LOCTEXT("InheritedVariableTooltip","Default value set in a parent blueprint");
+			}
+			else if(Reference.bIsOverride)
+			{
+				const FName DeclaringName = DeclaringBlueprint ? DeclaringBlueprint->GetFName() : NAME_None;
+				Result->SetDeferredName(EHRFDisplayKind::Variable, LOCTEXT("OverriddenVariable","{0} (Inherited from {1}, overridden)"), Reference.PropertyName, DeclaringName, DeclaringClass);
+				Result->Tooltip = LOCTEXT("OverriddenVariableTooltip","Default value of an inherited variable that this blueprint overrides");
+			}
+			else if(bIsVar)
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Variable, LOCTEXT("MemberVariable","{0} (Member Variable)"), Reference.PropertyName, NAME_None, DeclaringClass);
+				Result->Tooltip = LOCTEXT("MemberVariableTooltip","Blueprint member variable");
+			}
+			else
+			{
+				Result->SetDeferredName(EHRFDisplayKind::Named, LOCTEXT("OtherPropertyName", "{0}"), Reference.PropertyName);
+			}
+		}
+		OverriddenProperties.Append(Analysis->OverriddenProperties);
+	}
+
+	// The parent blueprints themselves are hard referenced by the generated class
+	for(const UClass* SuperClass = Blueprint->GeneratedClass->GetSuperClass(); Cast<UBlueprintGeneratedClass>(SuperClass) != nullptr; SuperClass = SuperClass->GetSuperClass())
+	{
+		if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, SuperClass->GetPackage()))
+		{
+			const bool bIsParent = SuperClass == Blueprint->GeneratedClass->GetSuperClass();
+			const UBlueprint* SuperBlueprint = UBlueprint::GetBlueprintFromClass(SuperClass);
+			const FName SuperName = SuperBlueprint ? SuperBlueprint->GetFName() : SuperClass->GetFName();
+			const FText NameFormat = bIsParent ? LOCTEXT("ParentClass", "{0} (Parent Class)") : LOCTEXT("AncestorClass", "{0} (Ancestor Class)");
+			Result->SetDeferredName(EHRFDisplayKind::Named, NameFormat, SuperName, NAME_None, UBlueprint::StaticClass());
+		}
+	}
+}
+
+void FHardReferenceFinderSearchData::AnalyzeClassProperties(FHRFClassAnalysis& OutAnalysis, const UClass* Class) const
+{
+	const UObject* DefaultObject = Class->GetDefaultObject();
+	const UClass* SuperClass = Class->GetSuperClass();
+	const UObject* SuperDefaultObject = SuperClass ? SuperClass->GetDefaultObject() : nullptr;
+	UBlueprint* Blueprint = UBlueprint::GetBlueprintFromClass(Class);
+	FHRFPackageCollector& ReferencedPackages = GetScratchPackages();
+
+	for( FProperty* Property : TFieldRange<FProperty>(Class, EFieldIteratorFlags::IncludeSuper))
 	{
+		const UClass* DeclaringClass = Property->GetOwnerClass();
+		const bool bIsDeclaredHere = DeclaringClass == Class;
+		if(!bIsDeclaredHere)
+		{
+			// Only defaults inherited from other blueprints are attributed; a value that matches the parent
+			// isn't saved in this class so the reference belongs to the parent's analysis.
+			const bool bIsBlueprintProperty = Cast<UBlueprintGeneratedClass>(DeclaringClass) != nullptr;
+			if(!bIsBlueprintProperty || SuperDefaultObject == nullptr || Property->Identical_InContainer(DefaultObject, SuperDefaultObject))
+			{
+				continue;
+			}
+			OutAnalysis.OverriddenProperties.Add(Property->GetFName());
+		}
+
 		UBlueprint* FoundBlueprint = nullptr;
 		const FName VarName = Property->GetFName();
-		const int32 VarIndex = FBlueprintEditorUtils::FindNewVariableIndexAndBlueprint(Blueprint, VarName, FoundBlueprint);
+		const int32 VarIndex = Blueprint ? FBlueprintEditorUtils::FindNewVariableIndexAndBlueprint(Blueprint, VarName, FoundBlueprint) : INDEX_NONE;
 		const bool bIsVar = VarIndex != INDEX_NONE;
 		
 		bool bSkipProperty = false;
@@ -493,51 +1693,69 @@ void FHardReferenceFinderSearchData::SearchBlueprintClassProperties(TMap<FName,
 		if(!bSkipProperty)
 		{
 			FSlateIcon ResultIcon;
-			TArray<UPackage*> ReferencedPackages = FindPackagesForProperty(ResultIcon, Blueprint->GeneratedClass->GetDefaultObject(), Property); 
+			const auto AddReference = [&](FName PackageName, bool bIsSoft)
+			{
+				FHRFPropertyReference& Reference = OutAnalysis.PropertyReferences.AddDefaulted_GetRef();
+				Reference.PackageName = PackageName;
+				Reference.PropertyName = VarName;
+				Reference.Icon = ResultIcon;
+				Reference.DeclaringClass = DeclaringClass;
+				Reference.bIsOverride = !bIsDeclaredHere;
+				Reference.bIsSoft = bIsSoft;
+			};
 
-			for(const UPackage* Package : ReferencedPackages)
+			// Soft references are always gathered, the analysis is cached for searches with and without them
+			ReferencedPackages.Reset();
+			FindPackagesForProperty(ReferencedPackages, ResultIcon, DefaultObject, Property);
+			FindSoftPackagesForProperty(ReferencedPackages, ResultIcon, DefaultObject, Property);
+			for(const UPackage* Package : ReferencedPackages.GetPackages())
 			{
-				if(const FHRFTreeViewItemPtr Result = CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Package))
-				{
-					if(bIsVar)
-					{
-						const FBPVariableDescription& Description = Blueprint->NewVariables[VarIndex];
-						if( UEdGraphSchema_K2 const* Schema = GetDefault<UEdGraphSchema_K2>() )
-						{
-							Result->IconColor = Schema->GetPinTypeColor(Description.VarType);
-						}
-						Result->SlateIcon = ResultIcon;
-						Result->Name = FText::Format(LOCTEXT("MemberVariable","{0} (Member Variable)"), FText::FromName(Description.VarName));
-						Result->Tooltip = LOCTEXT("MemberVariableTooltip","Blueprint member variable");
-					}
-					else
-					{
-						Result->SlateIcon = ResultIcon;
-						Result->Name = FText::Format(LOCTEXT("OtherPropertyName", "{0}"), FText::FromName(VarName));
-					}
-				}
+				AddReference(Package->GetFName(), false);
+			}
+			for(const FName& PackageName : ReferencedPackages.GetSoftPackages())
+			{
+				AddReference(PackageName, true);
 			}
 		}
 	}
 }
 
+FHRFTreeViewItemPtr FHardReferenceFinderSearchData::CheckAddSoftPackageResult(FName PackageName) const
+{
+	if(const FHRFTreeViewItemPtr* FoundHeader = SoftPackageMap.Find(PackageName))
+	{
+		FHRFTreeViewItemPtr Link = MakeShared<FHRFTreeViewItem>();
+		Link->bIsSoftReference = true;
+		(*FoundHeader)->Children.Add(Link);
+		return Link;
+	}
+
+	return nullptr;
+}
+
 FHRFTreeViewItemPtr FHardReferenceFinderSearchData::CheckAddPackageResult(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UPackage* Package) const
 {
 	if( Package )
 	{
-		const FName PackageName = Package->GetFName();
-		if(const FHRFTreeViewItemPtr* FoundHeader = OutPackageMap.Find(PackageName))
+		return CheckAddPackageResult(OutPackageMap, AssetRegistryModule, Package->GetFName());
+	}
+
+	return nullptr;
+}
+
+FHRFTreeViewItemPtr FHardReferenceFinderSearchData::CheckAddPackageResult(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, FName PackageName) const
+{
+	if(const FHRFTreeViewItemPtr* FoundHeader = OutPackageMap.Find(PackageName))
+	{
+		const FHRFTreeViewItemPtr Header = *FoundHeader;
+							
+		FAssetPackageData AssetPackageData;
+		const bool bExists = TryGetAssetPackageData(PackageName, AssetPackageData, AssetRegistryModule);
+		if(ensure(bExists))
 		{
-			const FHRFTreeViewItemPtr Header = *FoundHeader;
-								
-			FAssetPackageData AssetPackageData;
-			const bool bExists = TryGetAssetPackageData(PackageName, AssetPackageData, AssetRegistryModule);
-			if(ensure(bExists))
-			{
-				FHRFTreeViewItemPtr Link = MakeShared<FHRFTreeViewItem>();
-				Header->Children.Add(Link);
-				return Link; 
-			}
+			FHRFTreeViewItemPtr Link = MakeShared<FHRFTreeViewItem>();
+			Header->Children.Add(Link);
+			return Link; 
 		}
 	}
 
@@ -612,40 +1830,97 @@ FAssetData FHardReferenceFinderSearchData::GetAssetDataForObject(const UObject*
 #endif
 }
 
-int64 FHardReferenceFinderSearchData::GatherAssetSizeByName(const FName& AssetName, FAssetRegistryModule& AssetRegistryModule) const
+TSharedRef<const FHRFClosureSize> FHardReferenceFinderSearchData::GatherClosureSize(const FName& AssetName, FAssetRegistryModule& AssetRegistryModule) const
 {
-	TSet<FName> Visited;
-	const int64 Size = GatherAssetSizeRecursive(AssetName, Visited, AssetRegistryModule);
-	return Size;
+	// Closures are shared between searches, e.g. every child of a blueprint has the same closure for its parent
+	const FName CookedPlatform = CookedRegistry.IsValid() ? SizePlatform : NAME_None;
+	return FHardReferenceFinderCache::Get().FindOrAddClosureSize(AssetName, CookedPlatform, [this, &AssetName, &AssetRegistryModule](FHRFClosureSize& OutClosureSize)
+	{
+		TMap<FName, int64> Visited;
+		OutClosureSize.TotalSize = GatherClosurePackages(AssetName, Visited, AssetRegistryModule);
+		OutClosureSize.NumPackages = Visited.Num();
+
+		// The walk already knows the size of every package, so the breakdown only needs their classes, which are
+		// looked up in a single batch.
+		const FHRFChunkSet* RootChunks = CookedRegistry.IsValid() ? CookedRegistry->FindChunks(AssetName) : nullptr;
+		TArray<FName> SizedPackages;
+		for(const TPair<FName, int64>& Package : Visited)
+		{
+			if(Package.Value > 0)
+			{
+				SizedPackages.Add(Package.Key);
+				OutClosureSize.SizeByFolder.FindOrAdd(HardReferenceSearchInternals::GetTopLevelFolder(Package.Key)) += Package.Value;
+			}
+
+			// Chunk sets are bitsets, so merging them stays cheap however many packages share the same chunks
+			if(const FHRFChunkSet* PackageChunks = CookedRegistry.IsValid() ? CookedRegistry->FindChunks(Package.Key) : nullptr)
+			{
+				OutClosureSize.Chunks.Append(*PackageChunks);
+				if(RootChunks && !PackageChunks->IsEmpty() && !PackageChunks->Intersects(*RootChunks))
+				{
+					OutClosureSize.ForeignChunkSize += Package.Value;
+				}
+			}
+		}
+
+		TMap<FName, FAssetData> PackageToAssetData;
+		GetAssetForPackages(SizedPackages, PackageToAssetData);
+		for(const FName& PackageName : SizedPackages)
+		{
+			const FAssetData* AssetData = PackageToAssetData.Find(PackageName);
+			const FName ClassName = AssetData ? FName(*GetAssetTypeName(*AssetData)) : FName(TEXT("Other"));
+			OutClosureSize.SizeByClass.FindOrAdd(ClassName) += Visited[PackageName];
+		}
+	});
 }
 
-int64 FHardReferenceFinderSearchData::GatherAssetSizeRecursive(const FName& AssetName, TSet<FName>& OutVisited, FAssetRegistryModule& AssetRegistryModule) const
+int64 FHardReferenceFinderSearchData::GatherClosurePackages(const FName& AssetName, TMap<FName, int64>& OutVisited, FAssetRegistryModule& AssetRegistryModule) const
 {
-	const bool bAlreadyVisited = OutVisited.Contains(AssetName);
-	if(bAlreadyVisited)
+	// Dependency chains in large projects are deep enough to overflow the stack when walked recursively, so the walk
+	// keeps its own stack of packages still to visit
+	int64 TotalSize = 0;
+	TArray<FName> Stack = {AssetName};
+	TArray<FName> Dependencies;
+	const UE::AssetRegistry::FDependencyQuery Flags(UE::AssetRegistry::EDependencyQuery::Hard);
+	while(Stack.Num() > 0)
 	{
-		return 0;
+		const FName PackageName = Stack.Pop(false);
+		if(OutVisited.Contains(PackageName))
+		{
+			continue;
+		}
+
+		const int64 PackageSize = GetPackageSize(PackageName, AssetRegistryModule);
+		OutVisited.Add(PackageName, PackageSize);
+		TotalSize += PackageSize;
+
+		Dependencies.Reset();
+		AssetRegistryModule.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, Flags);
+		for(const FName& DependencyName : Dependencies)
+		{
+			if(!OutVisited.Contains(DependencyName))
+			{
+				Stack.Add(DependencyName);
+			}
+		}
 	}
-	OutVisited.Add(AssetName);
+	return TotalSize;
+}
 
-	int64 AssetSize = 0;
-	FAssetPackageData AssetPackageData;
-	if( TryGetAssetPackageData(AssetName, AssetPackageData, AssetRegistryModule) )
+int64 FHardReferenceFinderSearchData::GetPackageSize(FName PackageName, const FAssetRegistryModule& AssetRegistryModule) const
+{
+	// Dependencies still come from the editor registry, only the size of each package is taken from the cook
+	if(CookedRegistry.IsValid())
 	{
-		AssetSize += AssetPackageData.DiskSize;
+		return CookedRegistry->GetCookedSize(PackageName);
 	}
-	
-	TArray<FName> Dependencies;
-	const UE::AssetRegistry::FDependencyQuery Flags(UE::AssetRegistry::EDependencyQuery::Hard);
-	AssetRegistryModule.GetDependencies(AssetName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, Flags);
-	int64 DependencySize = 0;	
-	for(const FName& DependencyName : Dependencies)
+
+	FAssetPackageData AssetPackageData;
+	if( TryGetAssetPackageData(PackageName, AssetPackageData, AssetRegistryModule) )
 	{
-		DependencySize += GatherAssetSizeRecursive(DependencyName, OutVisited, AssetRegistryModule);  
+		return AssetPackageData.DiskSize;
 	}
-
-	const int64 TotalSize = AssetSize + DependencySize; 
-	return TotalSize;
+	return 0;
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,243 @@
+#include "HardReferenceFinderSnapshot.h"
+#include "HardReferenceFinderResultsFile.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+
+#define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
+
+namespace HardReferenceSnapshotInternals
+{
+	// Snapshots were written with an FArchive before the results file format existed, they can still be loaded.
+	static const uint32 LegacySnapshotMagic = 0x53465248; // 'HRFS'
+	static const int32 LegacySnapshotVersion = 1;
+
+	static bool LoadLegacySnapshot(FArchive& Ar, FName& OutBlueprintPackage, TArray<FHRFSnapshotPackage>& OutPackages)
+	{
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Ar << Magic;
+		Ar << Version;
+		if(Magic != LegacySnapshotMagic || Version != LegacySnapshotVersion)
+		{
+			return false;
+		}
+
+		Ar << OutBlueprintPackage;
+
+		int32 NumPackages = 0;
+		Ar << NumPackages;
+		for(int32 PackageIndex = 0; PackageIndex < NumPackages && !Ar.IsError(); ++PackageIndex)
+		{
+			FHRFSnapshotPackage& Package = OutPackages.AddDefaulted_GetRef();
+			Ar << Package.PackageId;
+			Ar << Package.SizeOnDisk;
+
+			TArray<FString> SourceNames;
+			Ar << SourceNames;
+			for(FString& SourceName : SourceNames)
+			{
+				Package.Sources.AddDefaulted_GetRef().Name = MoveTemp(SourceName);
+			}
+		}
+		return !Ar.IsError();
+	}
+
+	/*
+	 * Sources of a baseline package keyed the way they are matched: by node or component when the source has one, so
+	 * renaming a node doesn't show it as removed and added again, and by name otherwise, e.g. for legacy snapshots
+	 */
+	struct FBaselineSources
+	{
+		explicit FBaselineSources(const TArray<FHRFSnapshotSource>& Sources)
+		{
+			for(const FHRFSnapshotSource& Source : Sources)
+			{
+				if(Source.NodeGuid.IsValid())
+				{
+					NodeGuids.Add(Source.NodeGuid);
+				}
+				else if(!Source.SCSIdentifier.IsNone())
+				{
+					SCSIdentifiers.Add(Source.SCSIdentifier);
+				}
+				else
+				{
+					Names.Add(Source.Name);
+				}
+			}
+		}
+
+		bool Contains(FHRFTreeViewItem& Source) const
+		{
+			if(Source.NodeGuid.IsValid() && NodeGuids.Contains(Source.NodeGuid))
+			{
+				return true;
+			}
+			if(!Source.SCSIdentifier.IsNone() && SCSIdentifiers.Contains(Source.SCSIdentifier))
+			{
+				return true;
+			}
+			if(Names.Num() == 0)
+			{
+				return false;
+			}
+
+			// Only names have to be resolved, the icon is left for when the row is displayed
+			Source.ResolveDisplayInfo(true);
+			return Names.Contains(Source.Name.ToString());
+		}
+
+		TSet<FGuid> NodeGuids;
+		TSet<FName> SCSIdentifiers;
+		TSet<FString> Names;
+	};
+}
+
+FHardReferenceFinderSnapshot::FHardReferenceFinderSnapshot(FName InBlueprintPackage, TArray<FHRFSnapshotPackage>&& InPackages, int64 InClosureSize)
+	: BlueprintPackage(InBlueprintPackage)
+	, Packages(MoveTemp(InPackages))
+	, ClosureSize(InClosureSize)
+{
+}
+
+FHardReferenceFinderSnapshot FHardReferenceFinderSnapshot::FromSearchResults(FName InBlueprintPackage, const TArray<FHRFTreeViewItemPtr>& Results, int64 ClosureSize)
+{
+	FHardReferenceFinderSnapshot Snapshot;
+	Snapshot.BlueprintPackage = InBlueprintPackage;
+	Snapshot.ClosureSize = ClosureSize;
+	Snapshot.Packages.Reserve(Results.Num());
+
+	for(const FHRFTreeViewItemPtr& Header : Results)
+	{
+		// Removed headers are only present while a diff is displayed and headers without a package summarize or
+		// explain the results, neither are references of the blueprint. Soft references are optional and not compared.
+		if(!Header.IsValid() || !Header->bIsHeader || Header->bIsSoftReference || Header->DiffState == EHRFDiffState::Removed || Header->PackageId.IsNone())
+		{
+			continue;
+		}
+
+		FHRFSnapshotPackage& Package = Snapshot.Packages.AddDefaulted_GetRef();
+		Package.PackageId = Header->PackageId;
+		Package.SizeOnDisk = Header->SizeOnDisk;
+		Package.Sources.Reserve(Header->Children.Num());
+		for(const FHRFTreeViewItemPtr& Child : Header->Children)
+		{
+			// Snapshots only keep the name, icons are left for when the row is displayed, if ever
+			Child->ResolveDisplayInfo(true);
+			FHRFSnapshotSource& Source = Package.Sources.AddDefaulted_GetRef();
+			Source.Name = Child->Name.ToString();
+			Source.NodeGuid = Child->NodeGuid;
+			Source.SCSIdentifier = Child->SCSIdentifier;
+		}
+	}
+
+	return Snapshot;
+}
+
+bool FHardReferenceFinderSnapshot::SaveToFile(const FString& FileName) const
+{
+	FHardReferenceFinderResultsWriter Writer;
+	Writer.AddBlueprint(*this);
+	return Writer.SaveToFile(FileName);
+}
+
+bool FHardReferenceFinderSnapshot::LoadFromFile(const FString& FileName, FName InBlueprintPackage)
+{
+	if(const TUniquePtr<FHardReferenceFinderResultsFile> ResultsFile = FHardReferenceFinderResultsFile::Open(FileName))
+	{
+		int32 BlueprintIndex = ResultsFile->FindBlueprint(InBlueprintPackage);
+		if(BlueprintIndex == INDEX_NONE && ResultsFile->GetNumBlueprints() == 1)
+		{
+			BlueprintIndex = 0;
+		}
+		return BlueprintIndex != INDEX_NONE && ResultsFile->ReadBlueprint(BlueprintIndex, *this);
+	}
+
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *FileName))
+	{
+		return false;
+	}
+
+	FName LoadedBlueprintPackage;
+	TArray<FHRFSnapshotPackage> LoadedPackages;
+	FMemoryReader Reader(Bytes, true);
+	if(!HardReferenceSnapshotInternals::LoadLegacySnapshot(Reader, LoadedBlueprintPackage, LoadedPackages))
+	{
+		return false;
+	}
+
+	*this = FHardReferenceFinderSnapshot(LoadedBlueprintPackage, MoveTemp(LoadedPackages));
+	return true;
+}
+
+void FHardReferenceFinderSnapshot::ApplyDiff(TArray<FHRFTreeViewItemPtr>& InOutResults) const
+{
+	TMap<FName, const FHRFSnapshotPackage*> BaselinePackages;
+	BaselinePackages.Reserve(Packages.Num());
+	for(const FHRFSnapshotPackage& Package : Packages)
+	{
+		BaselinePackages.Add(Package.PackageId, &Package);
+	}
+
+	for(const FHRFTreeViewItemPtr& Header : InOutResults)
+	{
+		if(!Header->bIsHeader || Header->bIsSoftReference || Header->PackageId.IsNone())
+		{
+			continue;
+		}
+
+		const FHRFSnapshotPackage* const* Baseline = BaselinePackages.Find(Header->PackageId);
+		if(Baseline == nullptr)
+		{
+			Header->DiffState = EHRFDiffState::Added;
+			Header->SizeDelta = Header->SizeOnDisk;
+			continue;
+		}
+
+		Header->SizeDelta = Header->SizeOnDisk - (*Baseline)->SizeOnDisk;
+		Header->DiffState = Header->SizeDelta != 0 ? EHRFDiffState::Changed : EHRFDiffState::Unchanged;
+
+		// Sources that weren't present in the baseline are highlighted individually
+		const HardReferenceSnapshotInternals::FBaselineSources BaselineSources((*Baseline)->Sources);
+		for(const FHRFTreeViewItemPtr& Child : Header->Children)
+		{
+			Child->DiffState = BaselineSources.Contains(*Child) ? EHRFDiffState::Unchanged : EHRFDiffState::Added;
+		}
+		BaselinePackages.Remove(Header->PackageId);
+	}
+
+	// Anything left over is no longer referenced by the blueprint
+	for(const TPair<FName, const FHRFSnapshotPackage*>& Pair : BaselinePackages)
+	{
+		const FHRFSnapshotPackage& Package = *Pair.Value;
+
+		FHRFTreeViewItemPtr Header = MakeShared<FHRFTreeViewItem>();
+		Header->bIsHeader = true;
+		Header->PackageId = Package.PackageId;
+		Header->Name = FText::FromString(FPaths::GetCleanFilename(Package.PackageId.ToString()));
+		Header->Tooltip = FText::Format(LOCTEXT("RemovedPackageTooltip", "{0}\nNo longer referenced by this blueprint."), FText::FromName(Package.PackageId));
+		Header->SizeOnDisk = Package.SizeOnDisk;
+		Header->SizeDelta = -Package.SizeOnDisk;
+		Header->DiffState = EHRFDiffState::Removed;
+
+		for(const FHRFSnapshotSource& Source : Package.Sources)
+		{
+			FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+			Child->Name = FText::FromString(Source.Name);
+			Child->NodeGuid = Source.NodeGuid;
+			Child->SCSIdentifier = Source.SCSIdentifier;
+			Child->DiffState = EHRFDiffState::Removed;
+			Header->Children.Add(Child);
+		}
+		InOutResults.Add(Header);
+	}
+
+	// Keep the largest changes at the top while diffing
+	InOutResults.StableSort([](const FHRFTreeViewItemPtr& Lhs, const FHRFTreeViewItemPtr& Rhs)
+	{
+		return FMath::Abs(Lhs->SizeDelta) > FMath::Abs(Rhs->SizeDelta);
+	});
+}
+
+#undef LOCTEXT_NAMESPACE
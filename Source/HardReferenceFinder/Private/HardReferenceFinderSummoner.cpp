@@ -4,6 +4,7 @@
 #include "HardReferenceFinderStyle.h"
 #include "BlueprintEditor.h"
 #include "SHardReferenceFinderWindow.h"
+#include "Widgets/Docking/SDockTab.h"
 
 #define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
 
@@ -21,10 +22,24 @@ FHardReferenceFinderSummoner::FHardReferenceFinderSummoner(TSharedPtr<FAssetEdit
 	ViewMenuTooltip = LOCTEXT("HardReferenceFinderView_ToolTip", "Shows hard referencing nodes associated with this Blueprint");
 }
 
+TSharedRef<SDockTab> FHardReferenceFinderSummoner::SpawnTab(const FWorkflowTabSpawnInfo& Info) const
+{
+	// The base class creates the tab around CreateTabBody, so the window is only known to it from there
+	const TSharedRef<SDockTab> Tab = FWorkflowTabFactory::SpawnTab(Info);
+	if(const TSharedPtr<SHardReferenceFinderWindow> Window = SpawningWindow.Pin())
+	{
+		Window->SetOwnerTab(Tab);
+	}
+	SpawningWindow.Reset();
+	return Tab;
+}
+
 TSharedRef<SWidget> FHardReferenceFinderSummoner::CreateTabBody(const FWorkflowTabSpawnInfo& Info) const
 {
 	const TSharedPtr<FBlueprintEditor> BlueprintEditorPtr = StaticCastSharedPtr<FBlueprintEditor>(HostingApp.Pin());
-	return SNew(SHardReferenceFinderWindow, BlueprintEditorPtr);	
+	const TSharedRef<SHardReferenceFinderWindow> Window = SNew(SHardReferenceFinderWindow, BlueprintEditorPtr);
+	SpawningWindow = Window;
+	return Window;
 }
 
 FText FHardReferenceFinderSummoner::GetTabToolTipText(const FWorkflowTabSpawnInfo& Info) const
@@ -0,0 +1,423 @@
+#include "HardReferenceFinderTrendStore.h"
+#include "HardReferenceFinderMemory.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHardReferenceTrendStore, Log, All);
+
+TUniquePtr<FHardReferenceFinderTrendStore> FHardReferenceFinderTrendStore::Instance;
+
+namespace HardReferenceTrendInternals
+{
+	static constexpr uint32 Magic = 0x54465248; // 'HRFT'
+	static constexpr uint32 Version = 1;
+	static constexpr uint8 StringTag = 1;
+	static constexpr uint8 SampleTag = 2;
+
+	// How long an append waits for another process to finish its own, at most
+	static constexpr int32 MaxLockAttempts = 50;
+	static constexpr float LockRetrySeconds = 0.02f;
+
+	static void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+	{
+		do
+		{
+			const uint8 Byte = Value & 0x7f;
+			Value >>= 7;
+			Out.Add(Byte | (Value ? 0x80 : 0));
+		}
+		while(Value);
+	}
+
+	static void WriteVarInt(TArray<uint8>& Out, int64 Value)
+	{
+		WriteVarUInt(Out, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+	}
+
+	static bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint64& OutValue)
+	{
+		OutValue = 0;
+		for(int32 Shift = 0; Shift < 64 && Cursor < End; Shift += 7)
+		{
+			const uint8 Byte = *Cursor++;
+			OutValue |= static_cast<uint64>(Byte & 0x7f) << Shift;
+			if((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool ReadVarInt(const uint8*& Cursor, const uint8* End, int64& OutValue)
+	{
+		uint64 Encoded = 0;
+		if(!ReadVarUInt(Cursor, End, Encoded))
+		{
+			return false;
+		}
+		OutValue = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+		return true;
+	}
+
+	static bool IsSameSample(const FHRFTrendSample& Lhs, const FHRFTrendSample& Rhs)
+	{
+		return Lhs.Changelist == Rhs.Changelist && Lhs.TotalSize == Rhs.TotalSize && Lhs.NumPackages == Rhs.NumPackages && Lhs.TopHeaders == Rhs.TopHeaders;
+	}
+}
+
+void FHardReferenceFinderTrendStore::Initialize()
+{
+	if(!Instance.IsValid())
+	{
+		Instance = MakeUnique<FHardReferenceFinderTrendStore>();
+	}
+}
+
+void FHardReferenceFinderTrendStore::Shutdown()
+{
+	Instance.Reset();
+	SET_DWORD_STAT(STAT_HRF_NumHistorySamples, 0);
+	SET_MEMORY_STAT(STAT_HRF_HistoryMemory, 0);
+}
+
+FHardReferenceFinderTrendStore& FHardReferenceFinderTrendStore::Get()
+{
+	check(Instance.IsValid());
+	return *Instance;
+}
+
+FHardReferenceFinderTrendStore::FHardReferenceFinderTrendStore(const FString& InStorePath)
+	: StorePath(InStorePath)
+{
+}
+
+FString FHardReferenceFinderTrendStore::GetStorePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HardReferenceFinder"), TEXT("ClosureHistory.hrftrend"));
+}
+
+int32 FHardReferenceFinderTrendStore::GetCurrentChangelist()
+{
+	// The engine's own changelist says nothing about the project's content, so nothing is recorded without the switch
+	int32 Changelist = 0;
+	FParse::Value(FCommandLine::Get(), TEXT("HardReferenceChangelist="), Changelist);
+	return FMath::Max(Changelist, 0);
+}
+
+void FHardReferenceFinderTrendStore::Record(FName BlueprintPackage, const FHRFTrendSample& Sample)
+{
+	using namespace HardReferenceTrendInternals;
+	LLM_SCOPE_BYTAG(HardReferenceFinder_History);
+	LoadIfNeeded();
+	if(!bIsWritable)
+	{
+		return;
+	}
+
+	// Holding the file open for writing keeps every other process from appending until this sample is written
+	TUniquePtr<IFileHandle> File;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(StorePath));
+	for(int32 Attempt = 0; Attempt < MaxLockAttempts && !File.IsValid(); ++Attempt)
+	{
+		File.Reset(PlatformFile.OpenWrite(*StorePath, true, true));
+		if(!File.IsValid())
+		{
+			FPlatformProcess::Sleep(LockRetrySeconds);
+		}
+	}
+	if(!File.IsValid())
+	{
+		UE_LOG(LogHardReferenceTrendStore, Warning, TEXT("%s is being written by another process, a closure sample of %s was not recorded"), *StorePath, *BlueprintPackage.ToString());
+		return;
+	}
+
+	// Whatever other processes appended decides the string ids and the deltas of this sample
+	const EReadResult ReadResult = ReadNewRecords(*File);
+	if(ReadResult != EReadResult::Complete)
+	{
+		bIsWritable = false;
+		UE_LOG(LogHardReferenceTrendStore, Warning, TEXT("%s can't be read past %lld bytes, no more history will be recorded to it. Move or delete it to start a new history."), *StorePath, ReadOffset);
+		return;
+	}
+
+	TArray<FHRFTrendSample>& History = Histories.FindOrAdd(BlueprintPackage);
+	const FHRFTrendSample Previous = History.Num() > 0 ? History.Last() : FHRFTrendSample();
+	if(History.Num() > 0 && IsSameSample(Previous, Sample))
+	{
+		return;
+	}
+
+	TArray<uint8> Records;
+	if(ReadOffset == 0)
+	{
+		uint32 FileHeader[2] = {Magic, Version};
+		Records.Append(reinterpret_cast<const uint8*>(FileHeader), sizeof(FileHeader));
+	}
+
+	// Strings used by the sample are defined first, so they can be resolved while reading it
+	const uint32 BlueprintString = FindOrAddString(BlueprintPackage, Records);
+	TArray<uint32> TopHeaderStrings;
+	for(const TPair<FName, int64>& TopHeader : Sample.TopHeaders)
+	{
+		TopHeaderStrings.Add(FindOrAddString(TopHeader.Key, Records));
+	}
+
+	Records.Add(SampleTag);
+	WriteVarUInt(Records, BlueprintString);
+	WriteVarInt(Records, Sample.Timestamp - Previous.Timestamp);
+	WriteVarInt(Records, static_cast<int64>(Sample.Changelist) - Previous.Changelist);
+	WriteVarInt(Records, Sample.TotalSize - Previous.TotalSize);
+	WriteVarInt(Records, static_cast<int64>(Sample.NumPackages) - Previous.NumPackages);
+	WriteVarUInt(Records, Sample.TopHeaders.Num());
+	for(int32 TopIndex = 0; TopIndex < Sample.TopHeaders.Num(); ++TopIndex)
+	{
+		WriteVarUInt(Records, TopHeaderStrings[TopIndex]);
+		WriteVarUInt(Records, static_cast<uint64>(FMath::Max<int64>(Sample.TopHeaders[TopIndex].Value, 0)));
+	}
+
+	if(!File->SeekFromEnd(0) || !File->Write(Records.GetData(), Records.Num()))
+	{
+		// The strings defined above may or may not have made it to the file, so everything is read again next time
+		UE_LOG(LogHardReferenceTrendStore, Warning, TEXT("Failed to append to %s"), *StorePath);
+		ResetContents();
+		bIsLoaded = false;
+		return;
+	}
+	ReadOffset += Records.Num();
+	History.Add(Sample);
+	UpdateStats();
+}
+
+const TArray<FHRFTrendSample>& FHardReferenceFinderTrendStore::GetHistory(FName BlueprintPackage)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_History);
+	LoadIfNeeded();
+	RefreshFromFile();
+	return Histories.FindOrAdd(BlueprintPackage);
+}
+
+TArray<int32> FHardReferenceFinderTrendStore::FindBiggestRegressions(const TArray<FHRFTrendSample>& History, int32 MaxRegressions)
+{
+	TArray<int32> Regressions;
+	for(int32 SampleIndex = 1; SampleIndex < History.Num(); ++SampleIndex)
+	{
+		if(History[SampleIndex].TotalSize > History[SampleIndex - 1].TotalSize)
+		{
+			Regressions.Add(SampleIndex);
+		}
+	}
+	Regressions.Sort([&History](int32 Lhs, int32 Rhs)
+	{
+		return History[Lhs].TotalSize - History[Lhs - 1].TotalSize > History[Rhs].TotalSize - History[Rhs - 1].TotalSize;
+	});
+	if(Regressions.Num() > MaxRegressions)
+	{
+		Regressions.SetNum(MaxRegressions);
+	}
+	return Regressions;
+}
+
+void FHardReferenceFinderTrendStore::LoadIfNeeded()
+{
+	if(bIsLoaded)
+	{
+		return;
+	}
+	bIsLoaded = true;
+	RefreshFromFile();
+}
+
+void FHardReferenceFinderTrendStore::RefreshFromFile()
+{
+	// Opened for reading only and shared with writers, a record another process is still writing is simply not read yet
+	TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*StorePath, true));
+	if(!File.IsValid())
+	{
+		return;
+	}
+
+	const EReadResult ReadResult = ReadNewRecords(*File);
+	File.Reset();
+	if(ReadResult == EReadResult::IncompleteTail && !bHasWarnedIncompleteTail)
+	{
+		bHasWarnedIncompleteTail = true;
+		UE_LOG(LogHardReferenceTrendStore, Warning, TEXT("Stopped reading %s at an incomplete record after %lld bytes, it may still be being written"), *StorePath, ReadOffset);
+	}
+	else if(ReadResult == EReadResult::BadHeader)
+	{
+		// Unreadable history can't be appended to. It's kept next to the new store, e.g. for a newer version of the
+		// plugin to read, and a fresh store is started so future samples aren't lost.
+		const FString BackupPath = StorePath + TEXT(".bak");
+		if(IFileManager::Get().Move(*BackupPath, *StorePath, true))
+		{
+			UE_LOG(LogHardReferenceTrendStore, Warning, TEXT("%s is not a closure history this version can read, it was moved to %s and a new history was started"), *StorePath, *BackupPath);
+		}
+		else
+		{
+			bIsWritable = false;
+			UE_LOG(LogHardReferenceTrendStore, Warning, TEXT("%s is not a closure history this version can read and could not be moved aside, no history will be recorded"), *StorePath);
+		}
+	}
+}
+
+FHardReferenceFinderTrendStore::EReadResult FHardReferenceFinderTrendStore::ReadNewRecords(IFileHandle& File)
+{
+	using namespace HardReferenceTrendInternals;
+
+	// A file shorter than what was read has been deleted or replaced, the ids read so far no longer mean anything
+	const int64 FileSize = File.Size();
+	if(FileSize < ReadOffset)
+	{
+		ResetContents();
+	}
+	if(FileSize == ReadOffset)
+	{
+		return EReadResult::Complete;
+	}
+
+	TArray<uint8> FileData;
+	FileData.SetNumUninitialized(static_cast<int32>(FileSize - ReadOffset));
+	if(!File.Seek(ReadOffset) || !File.Read(FileData.GetData(), FileData.Num()))
+	{
+		return EReadResult::IncompleteTail;
+	}
+
+	int64 Offset = 0;
+	if(ReadOffset == 0)
+	{
+		const int32 HeaderSize = 2 * sizeof(uint32);
+		uint32 FileHeader[2] = {0, 0};
+		if(FileData.Num() < HeaderSize)
+		{
+			return EReadResult::IncompleteTail;
+		}
+		FMemory::Memcpy(FileHeader, FileData.GetData(), HeaderSize);
+		if(FileHeader[0] != Magic || FileHeader[1] != Version)
+		{
+			return EReadResult::BadHeader;
+		}
+		Offset = HeaderSize;
+	}
+
+	Offset += ParseRecords(FileData.GetData() + Offset, FileData.Num() - Offset);
+	ReadOffset += Offset;
+	UpdateStats();
+	return Offset == FileData.Num() ? EReadResult::Complete : EReadResult::IncompleteTail;
+}
+
+int64 FHardReferenceFinderTrendStore::ParseRecords(const uint8* Data, int64 NumBytes)
+{
+	using namespace HardReferenceTrendInternals;
+	const uint8* Cursor = Data;
+	const uint8* End = Data + NumBytes;
+	const uint8* LastCompleteRecord = Cursor;
+	while(Cursor < End)
+	{
+		const uint8 Tag = *Cursor++;
+		if(Tag == StringTag)
+		{
+			uint64 Length = 0;
+			if(!ReadVarUInt(Cursor, End, Length) || Length > static_cast<uint64>(End - Cursor))
+			{
+				break;
+			}
+			const FUTF8ToTCHAR String(reinterpret_cast<const ANSICHAR*>(Cursor), static_cast<int32>(Length));
+			const FName Name(FString(String.Length(), String.Get()));
+			StringIds.Add(Name, Strings.Add(Name));
+			Cursor += Length;
+		}
+		else if(Tag == SampleTag)
+		{
+			uint64 BlueprintString = 0;
+			int64 Deltas[4] = {0, 0, 0, 0};
+			uint64 NumTopHeaders = 0;
+			bool bIsValid = ReadVarUInt(Cursor, End, BlueprintString) && BlueprintString < static_cast<uint64>(Strings.Num());
+			for(int64& Delta : Deltas)
+			{
+				bIsValid = bIsValid && ReadVarInt(Cursor, End, Delta);
+			}
+			bIsValid = bIsValid && ReadVarUInt(Cursor, End, NumTopHeaders);
+
+			FHRFTrendSample Sample;
+			for(uint64 TopIndex = 0; bIsValid && TopIndex < NumTopHeaders; ++TopIndex)
+			{
+				uint64 PackageString = 0;
+				uint64 Size = 0;
+				bIsValid = ReadVarUInt(Cursor, End, PackageString) && PackageString < static_cast<uint64>(Strings.Num()) && ReadVarUInt(Cursor, End, Size);
+				if(bIsValid)
+				{
+					Sample.TopHeaders.Emplace(Strings[PackageString], static_cast<int64>(Size));
+				}
+			}
+			if(!bIsValid)
+			{
+				break;
+			}
+
+			TArray<FHRFTrendSample>& History = Histories.FindOrAdd(Strings[BlueprintString]);
+			const FHRFTrendSample Previous = History.Num() > 0 ? History.Last() : FHRFTrendSample();
+			Sample.Timestamp = Previous.Timestamp + Deltas[0];
+			Sample.Changelist = static_cast<int32>(Previous.Changelist + Deltas[1]);
+			Sample.TotalSize = Previous.TotalSize + Deltas[2];
+			Sample.NumPackages = static_cast<int32>(Previous.NumPackages + Deltas[3]);
+			History.Add(MoveTemp(Sample));
+		}
+		else
+		{
+			break;
+		}
+		LastCompleteRecord = Cursor;
+	}
+	return LastCompleteRecord - Data;
+}
+
+void FHardReferenceFinderTrendStore::ResetContents()
+{
+	Histories.Reset();
+	Strings.Reset();
+	StringIds.Reset();
+	ReadOffset = 0;
+}
+
+uint32 FHardReferenceFinderTrendStore::FindOrAddString(FName String, TArray<uint8>& OutRecords)
+{
+	if(const uint32* Existing = StringIds.Find(String))
+	{
+		return *Existing;
+	}
+
+	const FTCHARToUTF8 Utf8(*String.ToString());
+	OutRecords.Add(HardReferenceTrendInternals::StringTag);
+	HardReferenceTrendInternals::WriteVarUInt(OutRecords, Utf8.Length());
+	OutRecords.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	const uint32 StringId = Strings.Add(String);
+	StringIds.Add(String, StringId);
+	return StringId;
+}
+
+void FHardReferenceFinderTrendStore::UpdateStats() const
+{
+#if STATS
+	int32 NumSamples = 0;
+	SIZE_T Size = Histories.GetAllocatedSize() + Strings.GetAllocatedSize() + StringIds.GetAllocatedSize();
+	for(const TPair<FName, TArray<FHRFTrendSample>>& History : Histories)
+	{
+		NumSamples += History.Value.Num();
+		Size += History.Value.GetAllocatedSize();
+		for(const FHRFTrendSample& Sample : History.Value)
+		{
+			Size += Sample.TopHeaders.GetAllocatedSize();
+		}
+	}
+	SET_DWORD_STAT(STAT_HRF_NumHistorySamples, NumSamples);
+	SET_MEMORY_STAT(STAT_HRF_HistoryMemory, Size);
+#endif
+}
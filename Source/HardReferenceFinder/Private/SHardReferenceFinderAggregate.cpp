@@ -0,0 +1,320 @@
+#include "SHardReferenceFinderAggregate.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "HardReferenceFinderTextUtils.h"
+#include "Async/ParallelFor.h"
+#include "Editor.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+#define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
+
+namespace HardReferenceAggregateInternals
+{
+	class SAssetRow : public SMultiColumnTableRow<FHRFAggregateAssetPtr>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SAssetRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, FHRFAggregateAssetPtr InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow<FHRFAggregateAssetPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if(ColumnName == SHardReferenceFinderAggregate::ColumnAsset)
+			{
+				Text = Item->Name;
+			}
+			else if(ColumnName == SHardReferenceFinderAggregate::ColumnClosureSize)
+			{
+				Text = HardReferenceInternals::MakeBestSizeString(Item->ClosureSize);
+			}
+			else if(ColumnName == SHardReferenceFinderAggregate::ColumnUniqueSize)
+			{
+				Text = HardReferenceInternals::MakeBestSizeString(Item->UniqueSize);
+			}
+			else if(ColumnName == SHardReferenceFinderAggregate::ColumnSharedSize)
+			{
+				Text = HardReferenceInternals::MakeBestSizeString(Item->SharedSize);
+			}
+
+			return SNew(STextBlock)
+				.Text(Text)
+				.ToolTipText(FText::FromName(Item->AssetData.PackageName));
+		}
+
+	private:
+		FHRFAggregateAssetPtr Item;
+	};
+
+	class SPackageRow : public SMultiColumnTableRow<FHRFAggregatePackagePtr>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SPackageRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, FHRFAggregatePackagePtr InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow<FHRFAggregatePackagePtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if(ColumnName == SHardReferenceFinderAggregate::ColumnPackage)
+			{
+				Text = FText::FromName(Item->PackageName);
+			}
+			else if(ColumnName == SHardReferenceFinderAggregate::ColumnRefCount)
+			{
+				Text = FText::AsNumber(Item->RefCount);
+			}
+			else if(ColumnName == SHardReferenceFinderAggregate::ColumnPackageSize)
+			{
+				Text = HardReferenceInternals::MakeBestSizeString(Item->DiskSize);
+			}
+
+			return SNew(STextBlock)
+				.Text(Text);
+		}
+
+	private:
+		FHRFAggregatePackagePtr Item;
+	};
+}
+
+const FName SHardReferenceFinderAggregate::ColumnAsset("Asset");
+const FName SHardReferenceFinderAggregate::ColumnClosureSize("ClosureSize");
+const FName SHardReferenceFinderAggregate::ColumnUniqueSize("UniqueSize");
+const FName SHardReferenceFinderAggregate::ColumnSharedSize("SharedSize");
+const FName SHardReferenceFinderAggregate::ColumnPackage("Package");
+const FName SHardReferenceFinderAggregate::ColumnRefCount("RefCount");
+const FName SHardReferenceFinderAggregate::ColumnPackageSize("PackageSize");
+
+void SHardReferenceFinderAggregate::Construct(const FArguments& InArgs)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	ChildSlot[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(10.f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.Padding(8.f,4.f)
+			.VAlign(VAlign_Center)
+			[
+				SAssignNew(SummaryText, STextBlock)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("AggregateRefresh", "Refresh"))
+				.OnClicked(this, &SHardReferenceFinderAggregate::OnRefreshClicked)
+			]
+		]
+		+ SVerticalBox::Slot()
+		[
+			SNew(SSplitter)
+			.Orientation(Orient_Vertical)
+			+ SSplitter::Slot()
+			.Value(0.4f)
+			[
+				SAssignNew(AssetList, SListView<FHRFAggregateAssetPtr>)
+				.ListItemsSource(&Assets)
+				.OnGenerateRow(this, &SHardReferenceFinderAggregate::OnGenerateAssetRow)
+				.OnMouseButtonDoubleClick(this, &SHardReferenceFinderAggregate::OnDoubleClickAsset)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(ColumnAsset)
+					.DefaultLabel(LOCTEXT("AggregateColumnAsset", "Asset"))
+					.FillWidth(0.4f)
+					+ SHeaderRow::Column(ColumnClosureSize)
+					.DefaultLabel(LOCTEXT("AggregateColumnClosureSize", "Closure Size"))
+					.FillWidth(0.2f)
+					+ SHeaderRow::Column(ColumnUniqueSize)
+					.DefaultLabel(LOCTEXT("AggregateColumnUniqueSize", "Unique"))
+					.DefaultTooltip(LOCTEXT("AggregateColumnUniqueSizeTooltip", "Bytes only this asset pulls in, they are saved if it is removed from the set"))
+					.FillWidth(0.2f)
+					+ SHeaderRow::Column(ColumnSharedSize)
+					.DefaultLabel(LOCTEXT("AggregateColumnSharedSize", "Shared"))
+					.DefaultTooltip(LOCTEXT("AggregateColumnSharedSizeTooltip", "Bytes that other selected assets pull in as well"))
+					.FillWidth(0.2f)
+				)
+			]
+			+ SSplitter::Slot()
+			.Value(0.6f)
+			[
+				SAssignNew(PackageList, SListView<FHRFAggregatePackagePtr>)
+				.ListItemsSource(&Packages)
+				.OnGenerateRow(this, &SHardReferenceFinderAggregate::OnGeneratePackageRow)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(ColumnPackage)
+					.DefaultLabel(LOCTEXT("AggregateColumnPackage", "Package"))
+					.FillWidth(0.6f)
+					+ SHeaderRow::Column(ColumnRefCount)
+					.DefaultLabel(LOCTEXT("AggregateColumnRefCount", "Referenced By"))
+					.DefaultTooltip(LOCTEXT("AggregateColumnRefCountTooltip", "Number of selected assets whose closure contains this package"))
+					.FillWidth(0.2f)
+					+ SHeaderRow::Column(ColumnPackageSize)
+					.DefaultLabel(LOCTEXT("AggregateColumnPackageSize", "Size"))
+					.FillWidth(0.2f)
+				)
+			]
+		]
+	];
+}
+
+void SHardReferenceFinderAggregate::SetAssets(const TArray<FAssetData>& InAssets)
+{
+	SelectedAssets = InAssets;
+	RebuildAggregate();
+}
+
+void SHardReferenceFinderAggregate::RebuildAggregate()
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	Assets.Reset();
+	Packages.Reset();
+
+	FScopedSlowTask SlowTask(3.f, LOCTEXT("BuildingAggregate", "Measuring the combined hard references of the selected assets..."));
+	SlowTask.MakeDialogDelayed(1.f);
+
+	SlowTask.EnterProgressFrame();
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	for(const FAssetData& AssetData : SelectedAssets)
+	{
+		const int32 GraphIndex = Graph->FindPackage(AssetData.PackageName);
+		const bool bAlreadyAdded = Assets.ContainsByPredicate([GraphIndex](const FHRFAggregateAssetPtr& Asset)
+		{
+			return Asset->GraphIndex == GraphIndex;
+		});
+		if(GraphIndex == INDEX_NONE || bAlreadyAdded)
+		{
+			continue;
+		}
+
+		FHRFAggregateAssetPtr Asset = MakeShared<FHRFAggregateAsset>();
+		Asset->AssetData = AssetData;
+		Asset->Name = FText::FromName(AssetData.AssetName);
+		Asset->GraphIndex = GraphIndex;
+		Assets.Add(Asset);
+	}
+
+	// Closures are sets of component ordinals, so a few hundred of them fit in memory and combine with plain bit tests
+	SlowTask.EnterProgressFrame();
+	const int32 NumComponents = Graph->NumComponents();
+	TArray<TBitArray<>> Closures;
+	Closures.SetNum(Assets.Num());
+	ParallelFor(Assets.Num(), [this, &Graph, &Closures, NumComponents](int32 AssetIndex)
+	{
+		LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+		Closures[AssetIndex].Init(false, NumComponents);
+		Graph->GatherClosureComponents(Assets[AssetIndex]->GraphIndex, Closures[AssetIndex]);
+	});
+
+	TArray<int32> RefCounts;
+	RefCounts.Init(0, NumComponents);
+	for(const TBitArray<>& Closure : Closures)
+	{
+		for(TConstSetBitIterator<> It(Closure); It; ++It)
+		{
+			++RefCounts[It.GetIndex()];
+		}
+	}
+
+	SlowTask.EnterProgressFrame();
+	ParallelFor(Assets.Num(), [this, &Graph, &Closures, &RefCounts](int32 AssetIndex)
+	{
+		FHRFAggregateAsset& Asset = *Assets[AssetIndex];
+		for(TConstSetBitIterator<> It(Closures[AssetIndex]); It; ++It)
+		{
+			const int64 ComponentSize = Graph->GetComponentSize(It.GetIndex());
+			Asset.ClosureSize += ComponentSize;
+			(RefCounts[It.GetIndex()] == 1 ? Asset.UniqueSize : Asset.SharedSize) += ComponentSize;
+		}
+	});
+
+	int64 CombinedSize = 0;
+	int64 SharedSize = 0;
+	for(int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		CombinedSize += RefCounts[Component] > 0 ? Graph->GetComponentSize(Component) : 0;
+		SharedSize += RefCounts[Component] > 1 ? Graph->GetComponentSize(Component) : 0;
+	}
+
+	for(int32 Package = 0; Package < Graph->Num(); ++Package)
+	{
+		const int32 RefCount = RefCounts[Graph->GetComponent(Package)];
+		if(RefCount > 0)
+		{
+			FHRFAggregatePackagePtr Item = MakeShared<FHRFAggregatePackage>();
+			Item->PackageName = Graph->GetPackageName(Package);
+			Item->DiskSize = Graph->GetDiskSize(Package);
+			Item->RefCount = RefCount;
+			Packages.Add(Item);
+		}
+	}
+
+	Assets.Sort([](const FHRFAggregateAssetPtr& Lhs, const FHRFAggregateAssetPtr& Rhs)
+	{
+		return Lhs->ClosureSize > Rhs->ClosureSize;
+	});
+	Packages.Sort([](const FHRFAggregatePackagePtr& Lhs, const FHRFAggregatePackagePtr& Rhs)
+	{
+		return Lhs->RefCount != Rhs->RefCount ? Lhs->RefCount > Rhs->RefCount : Lhs->DiskSize > Rhs->DiskSize;
+	});
+
+	SummaryText->SetText(FText::Format(LOCTEXT("AggregateSummary", "{0} assets hard reference {1} packages, {2} combined. {3} of that is shared by more than one asset."),
+		Assets.Num(), Packages.Num(), HardReferenceInternals::MakeBestSizeString(CombinedSize), HardReferenceInternals::MakeBestSizeString(SharedSize)));
+	AssetList->RequestListRefresh();
+	PackageList->RequestListRefresh();
+}
+
+FReply SHardReferenceFinderAggregate::OnRefreshClicked()
+{
+	RebuildAggregate();
+	return FReply::Handled();
+}
+
+void SHardReferenceFinderAggregate::OnDoubleClickAsset(FHRFAggregateAssetPtr Item) const
+{
+	if(Item.IsValid() && GEditor)
+	{
+		if(UObject* Asset = Item->AssetData.GetAsset())
+		{
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Asset);
+		}
+	}
+}
+
+TSharedRef<ITableRow> SHardReferenceFinderAggregate::OnGenerateAssetRow(FHRFAggregateAssetPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	return SNew(HardReferenceAggregateInternals::SAssetRow, OwnerTable, Item);
+}
+
+TSharedRef<ITableRow> SHardReferenceFinderAggregate::OnGeneratePackageRow(FHRFAggregatePackagePtr Item, const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	return SNew(HardReferenceAggregateInternals::SPackageRow, OwnerTable, Item);
+}
+
+#undef LOCTEXT_NAMESPACE
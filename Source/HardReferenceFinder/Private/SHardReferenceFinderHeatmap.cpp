@@ -0,0 +1,364 @@
+#include "SHardReferenceFinderHeatmap.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "HardReferenceFinderTextUtils.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Misc/EngineVersionComparison.h"
+#include "STreeMap.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Images/SThrobber.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
+
+namespace HardReferenceHeatmapInternals
+{
+	// Only the largest blueprints are drawn in the tree map, the rest would be too small to read
+	static const int32 MaxTreeMapItems = 250;
+
+	class SHeatmapRow : public SMultiColumnTableRow<FHRFHeatmapItemPtr>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SHeatmapRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, FHRFHeatmapItemPtr InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow<FHRFHeatmapItemPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if(ColumnName == SHardReferenceFinderHeatmap::ColumnName)
+			{
+				Text = Item->Name;
+			}
+			else if(ColumnName == SHardReferenceFinderHeatmap::ColumnDependencies)
+			{
+				Text = FText::AsNumber(Item->NumDependencies);
+			}
+			else if(ColumnName == SHardReferenceFinderHeatmap::ColumnClosureSize)
+			{
+				Text = HardReferenceInternals::MakeBestSizeString(Item->ClosureSize);
+			}
+
+			return SNew(STextBlock)
+				.Text(Text)
+				.ToolTipText(FText::FromName(Item->AssetData.PackageName));
+		}
+
+	private:
+		FHRFHeatmapItemPtr Item;
+	};
+}
+
+const FName SHardReferenceFinderHeatmap::ColumnName("Blueprint");
+const FName SHardReferenceFinderHeatmap::ColumnDependencies("Dependencies");
+const FName SHardReferenceFinderHeatmap::ColumnClosureSize("ClosureSize");
+
+SHardReferenceFinderHeatmap::~SHardReferenceFinderHeatmap()
+{
+	// The worker reads the graph through a raw pointer, it has to finish before PendingGraph lets go of it
+	if(PendingClosureSizes.IsValid())
+	{
+		PendingClosureSizes.Wait();
+	}
+}
+
+void SHardReferenceFinderHeatmap::Construct(const FArguments& InArgs)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	SortColumn = ColumnClosureSize;
+	SortMode = EColumnSortMode::Descending;
+
+	TreeMapRoot = MakeShared<FTreeMapNodeData>();
+	TreeMapRoot->Name = LOCTEXT("HeatmapTreeMapRoot", "Blueprints").ToString();
+
+	ChildSlot[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(10.f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.Padding(8.f,4.f)
+			.VAlign(VAlign_Center)
+			[
+				SAssignNew(SummaryText, STextBlock)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8.f,4.f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(SThrobber)
+				.Visibility(this, &SHardReferenceFinderHeatmap::GetThrobberVisibility)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("HeatmapRefresh", "Refresh"))
+				.IsEnabled(this, &SHardReferenceFinderHeatmap::IsIdle)
+				.OnClicked(this, &SHardReferenceFinderHeatmap::OnRefreshClicked)
+			]
+		]
+		+ SVerticalBox::Slot()
+		[
+			SNew(SSplitter)
+			.Orientation(Orient_Vertical)
+			+ SSplitter::Slot()
+			.Value(0.5f)
+			[
+				SAssignNew(TreeMap, STreeMap, TreeMapRoot.ToSharedRef(), nullptr)
+			]
+			+ SSplitter::Slot()
+			.Value(0.5f)
+			[
+				SAssignNew(ListView, SListView<FHRFHeatmapItemPtr>)
+				.ListItemsSource(&Items)
+				.OnGenerateRow(this, &SHardReferenceFinderHeatmap::OnGenerateRow)
+				.OnMouseButtonDoubleClick(this, &SHardReferenceFinderHeatmap::OnDoubleClickItem)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(ColumnName)
+					.DefaultLabel(LOCTEXT("HeatmapColumnName", "Blueprint"))
+					.FillWidth(0.6f)
+					.SortMode(this, &SHardReferenceFinderHeatmap::GetSortMode, ColumnName)
+					.OnSort(this, &SHardReferenceFinderHeatmap::OnSortModeChanged)
+					+ SHeaderRow::Column(ColumnDependencies)
+					.DefaultLabel(LOCTEXT("HeatmapColumnDependencies", "Hard Dependencies"))
+					.FillWidth(0.2f)
+					.SortMode(this, &SHardReferenceFinderHeatmap::GetSortMode, ColumnDependencies)
+					.OnSort(this, &SHardReferenceFinderHeatmap::OnSortModeChanged)
+					+ SHeaderRow::Column(ColumnClosureSize)
+					.DefaultLabel(LOCTEXT("HeatmapColumnClosureSize", "Closure Size"))
+					.FillWidth(0.2f)
+					.SortMode(this, &SHardReferenceFinderHeatmap::GetSortMode, ColumnClosureSize)
+					.OnSort(this, &SHardReferenceFinderHeatmap::OnSortModeChanged)
+				)
+			]
+		]
+	];
+
+	RebuildHeatmap();
+}
+
+void SHardReferenceFinderHeatmap::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+	if(PendingClosureSizes.IsValid() && PendingClosureSizes.IsReady())
+	{
+		const TArray<int64> ClosureSizes = PendingClosureSizes.Get();
+		PendingClosureSizes = TFuture<TArray<int64>>();
+		OnClosureSizesMeasured(ClosureSizes);
+	}
+}
+
+void SHardReferenceFinderHeatmap::RebuildHeatmap()
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	Items.Reset();
+	ListView->RequestListRefresh();
+	RebuildTreeMap();
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	if(AssetRegistryModule.Get().IsLoadingAssets())
+	{
+		SummaryText->SetText(LOCTEXT("HeatmapRegistryLoading", "The asset registry is still discovering assets, refresh once it has finished."));
+		return;
+	}
+
+	bIsBuilding = true;
+	SummaryText->SetText(LOCTEXT("BuildingHeatmap", "Measuring the hard references of every blueprint..."));
+
+	// Called right away when the graph is already built, the heatmap may be closed by the time it is otherwise
+	const TWeakPtr<SHardReferenceFinderHeatmap> WeakHeatmap = SharedThis(this);
+	FHardReferenceFinderCache::Get().GetDependencyGraphAsync([WeakHeatmap](TSharedRef<const FHardReferenceFinderDependencyGraph> Graph)
+	{
+		if(const TSharedPtr<SHardReferenceFinderHeatmap> Heatmap = WeakHeatmap.Pin())
+		{
+			Heatmap->OnDependencyGraphBuilt(Graph);
+		}
+	});
+}
+
+void SHardReferenceFinderHeatmap::OnDependencyGraphBuilt(TSharedRef<const FHardReferenceFinderDependencyGraph> Graph)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	FARFilter Filter;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#else
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#endif
+	Filter.bRecursiveClasses = true;
+	TArray<FAssetData> Blueprints;
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().GetAssets(Filter, Blueprints);
+
+	PendingItems.Reset(Blueprints.Num());
+	TArray<int32> GraphIndices;
+	GraphIndices.Reserve(Blueprints.Num());
+	for(const FAssetData& AssetData : Blueprints)
+	{
+		const int32 GraphIndex = Graph->FindPackage(AssetData.PackageName);
+		if(GraphIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FHRFHeatmapItemPtr Item = MakeShared<FHRFHeatmapItem>();
+		Item->AssetData = AssetData;
+		Item->Name = FText::FromName(AssetData.AssetName);
+		Item->GraphIndex = GraphIndex;
+		Item->NumDependencies = Graph->GetDependencies(GraphIndex).Num();
+		PendingItems.Add(Item);
+		GraphIndices.Add(GraphIndex);
+	}
+
+	// The graph is read-only once built, so every blueprint's closure is walked on its own worker. The results are
+	// picked up in Tick.
+	PendingGraph = Graph;
+	const FHardReferenceFinderDependencyGraph* GraphPtr = &Graph.Get();
+	PendingClosureSizes = Async(EAsyncExecution::ThreadPool, [GraphPtr, GraphIndices = MoveTemp(GraphIndices)]()
+	{
+		TArray<int64> ClosureSizes;
+		ClosureSizes.SetNumZeroed(GraphIndices.Num());
+		ParallelFor(GraphIndices.Num(), [GraphPtr, &GraphIndices, &ClosureSizes](int32 ItemIndex)
+		{
+			LLM_SCOPE_BYTAG(HardReferenceFinder_Graph);
+			ClosureSizes[ItemIndex] = GraphPtr->GetClosureSize(GraphIndices[ItemIndex]);
+		});
+		return ClosureSizes;
+	});
+}
+
+void SHardReferenceFinderHeatmap::OnClosureSizesMeasured(const TArray<int64>& ClosureSizes)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	for(int32 ItemIndex = 0; ItemIndex < PendingItems.Num(); ++ItemIndex)
+	{
+		PendingItems[ItemIndex]->ClosureSize = ClosureSizes[ItemIndex];
+	}
+	Items = MoveTemp(PendingItems);
+
+	SummaryText->SetText(FText::Format(LOCTEXT("HeatmapSummary", "{0} blueprints, {1} packages in the dependency graph."), Items.Num(), PendingGraph->Num()));
+	PendingGraph.Reset();
+	bIsBuilding = false;
+	SortItems();
+	RebuildTreeMap();
+}
+
+bool SHardReferenceFinderHeatmap::IsIdle() const
+{
+	return !bIsBuilding;
+}
+
+EVisibility SHardReferenceFinderHeatmap::GetThrobberVisibility() const
+{
+	return bIsBuilding ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+void SHardReferenceFinderHeatmap::SortItems()
+{
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	if(SortColumn == ColumnName)
+	{
+		Items.Sort([bAscending](const FHRFHeatmapItemPtr& Lhs, const FHRFHeatmapItemPtr& Rhs)
+		{
+			const int32 Comparison = Lhs->Name.CompareTo(Rhs->Name);
+			return bAscending ? Comparison < 0 : Comparison > 0;
+		});
+	}
+	else if(SortColumn == ColumnDependencies)
+	{
+		Items.Sort([bAscending](const FHRFHeatmapItemPtr& Lhs, const FHRFHeatmapItemPtr& Rhs)
+		{
+			return bAscending ? Lhs->NumDependencies < Rhs->NumDependencies : Lhs->NumDependencies > Rhs->NumDependencies;
+		});
+	}
+	else
+	{
+		Items.Sort([bAscending](const FHRFHeatmapItemPtr& Lhs, const FHRFHeatmapItemPtr& Rhs)
+		{
+			return bAscending ? Lhs->ClosureSize < Rhs->ClosureSize : Lhs->ClosureSize > Rhs->ClosureSize;
+		});
+	}
+	ListView->RequestListRefresh();
+}
+
+void SHardReferenceFinderHeatmap::RebuildTreeMap()
+{
+	TArray<FHRFHeatmapItemPtr> LargestItems = Items;
+	LargestItems.Sort([](const FHRFHeatmapItemPtr& Lhs, const FHRFHeatmapItemPtr& Rhs)
+	{
+		return Lhs->ClosureSize > Rhs->ClosureSize;
+	});
+	if(LargestItems.Num() > HardReferenceHeatmapInternals::MaxTreeMapItems)
+	{
+		LargestItems.SetNum(HardReferenceHeatmapInternals::MaxTreeMapItems);
+	}
+
+	// Colors run from green for the smallest drawn closure to red for the largest
+	const double MaxSize = LargestItems.Num() > 0 ? FMath::Max<double>(LargestItems[0]->ClosureSize, 1.0) : 1.0;
+	TreeMapRoot->Children.Reset();
+	for(const FHRFHeatmapItemPtr& Item : LargestItems)
+	{
+		TSharedPtr<FTreeMapNodeData> Node = MakeShared<FTreeMapNodeData>();
+		Node->Name = Item->Name.ToString();
+		Node->Name2 = HardReferenceInternals::MakeBestSizeString(Item->ClosureSize).ToString();
+		Node->Size = static_cast<float>(Item->ClosureSize);
+		Node->Color = FLinearColor::LerpUsingHSV(FLinearColor(0.2f, 0.6f, 0.2f), FLinearColor(0.8f, 0.15f, 0.1f), static_cast<float>(Item->ClosureSize / MaxSize));
+		Node->Parent = TreeMapRoot.Get();
+		TreeMapRoot->Children.Add(Node);
+	}
+	TreeMap->RebuildTreeMap(false);
+}
+
+FReply SHardReferenceFinderHeatmap::OnRefreshClicked()
+{
+	RebuildHeatmap();
+	return FReply::Handled();
+}
+
+void SHardReferenceFinderHeatmap::OnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+	SortColumn = ColumnId;
+	SortMode = NewSortMode;
+	SortItems();
+}
+
+EColumnSortMode::Type SHardReferenceFinderHeatmap::GetSortMode(FName ColumnId) const
+{
+	return ColumnId == SortColumn ? SortMode : EColumnSortMode::None;
+}
+
+void SHardReferenceFinderHeatmap::OnDoubleClickItem(FHRFHeatmapItemPtr Item) const
+{
+	if(Item.IsValid() && GEditor)
+	{
+		if(UObject* Asset = Item->AssetData.GetAsset())
+		{
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Asset);
+		}
+	}
+}
+
+TSharedRef<ITableRow> SHardReferenceFinderHeatmap::OnGenerateRow(FHRFHeatmapItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	return SNew(HardReferenceHeatmapInternals::SHeatmapRow, OwnerTable, Item);
+}
+
+#undef LOCTEXT_NAMESPACE
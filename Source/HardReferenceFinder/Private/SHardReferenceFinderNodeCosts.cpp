@@ -0,0 +1,286 @@
+#include "SHardReferenceFinderNodeCosts.h"
+#include "Async/ParallelFor.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderMemory.h"
+#include "HardReferenceFinderTextUtils.h"
+#include "Rendering/DrawElements.h"
+#include "SGraphPanel.h"
+#include "Widgets/SOverlay.h"
+
+#define LOCTEXT_NAMESPACE "FHardReferenceFinderModule"
+
+namespace HardReferenceNodeCostsInternals
+{
+	static const FName GraphPanelType(TEXT("SGraphPanel"));
+	static const FName OverlayType(TEXT("SOverlay"));
+	static const FName NodeCostsType(TEXT("SHardReferenceFinderNodeCosts"));
+
+	// Below this zoom nodes are drawn as plain boxes and badges would cover most of them
+	static const float MinBadgeZoom = 0.25f;
+
+	static const FVector2D BadgePadding(4.f, 1.f);
+
+	static FSlateFontInfo GetBadgeFont()
+	{
+		return FCoreStyle::GetDefaultFontStyle("Bold", 8);
+	}
+
+	static void FindGraphPanels(const TSharedRef<SWidget>& Widget, TArray<TSharedRef<SWidget>>& OutPanels)
+	{
+		// Node widgets are children of the panel, nothing below it needs to be visited
+		if(Widget->GetType() == GraphPanelType)
+		{
+			OutPanels.Add(Widget);
+			return;
+		}
+
+		FChildren* Children = Widget->GetChildren();
+		for(int32 ChildIndex = 0; ChildIndex < Children->Num(); ++ChildIndex)
+		{
+			FindGraphPanels(Children->GetChildAt(ChildIndex), OutPanels);
+		}
+	}
+}
+
+void FHRFNodeCosts::SetResults(const TArray<FHRFTreeViewItemPtr>& SearchResults)
+{
+	Results = SearchResults;
+	Costs.Reset();
+	bIsBuilt = false;
+	if(bVisible)
+	{
+		BuildIfNeeded();
+	}
+}
+
+void FHRFNodeCosts::BuildIfNeeded()
+{
+	if(bIsBuilt)
+	{
+		return;
+	}
+	bIsBuilt = true;
+
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	Costs.Reset();
+
+	using namespace HardReferenceNodeCostsInternals;
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+
+	// Packages of every source, the last one holds everything that isn't a node. A package referenced by one node
+	// through several pins belongs to that node once.
+	TArray<FGuid> Nodes;
+	TMap<FGuid, int32> NodeIndices;
+	TArray<TArray<int32>> SourcePackages;
+	TArray<int32> OtherPackages;
+	for(const FHRFTreeViewItemPtr& Header : Results)
+	{
+		if(!Header->bIsHeader || Header->bIsSoftReference || Header->PackageId.IsNone() || Header->DiffState == EHRFDiffState::Removed)
+		{
+			continue;
+		}
+
+		const int32 Package = Graph->FindPackage(Header->PackageId);
+		if(Package == INDEX_NONE)
+		{
+			continue;
+		}
+
+		for(const FHRFTreeViewItemPtr& Child : Header->Children)
+		{
+			if(!Child->NodeGuid.IsValid())
+			{
+				OtherPackages.AddUnique(Package);
+				continue;
+			}
+
+			const int32* NodeIndex = NodeIndices.Find(Child->NodeGuid);
+			if(NodeIndex == nullptr)
+			{
+				NodeIndex = &NodeIndices.Add(Child->NodeGuid, Nodes.Add(Child->NodeGuid));
+				SourcePackages.AddDefaulted();
+			}
+			SourcePackages[*NodeIndex].AddUnique(Package);
+		}
+	}
+	if(Nodes.Num() == 0)
+	{
+		return;
+	}
+	SourcePackages.Add(MoveTemp(OtherPackages));
+
+	const int32 NumComponents = Graph->NumComponents();
+	TArray<TBitArray<>> Closures;
+	Closures.SetNum(SourcePackages.Num());
+	ParallelFor(SourcePackages.Num(), [&Graph, &SourcePackages, &Closures, NumComponents](int32 SourceIndex)
+	{
+		LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+		Closures[SourceIndex].Init(false, NumComponents);
+		for(const int32 Package : SourcePackages[SourceIndex])
+		{
+			Graph->GatherClosureComponents(Package, Closures[SourceIndex]);
+		}
+	});
+
+	TArray<int32> RefCounts;
+	RefCounts.Init(0, NumComponents);
+	for(const TBitArray<>& Closure : Closures)
+	{
+		for(TConstSetBitIterator<> It(Closure); It; ++It)
+		{
+			++RefCounts[It.GetIndex()];
+		}
+	}
+
+	for(int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		FHRFNodeCost& Cost = Costs.Add(Nodes[NodeIndex]);
+		for(TConstSetBitIterator<> It(Closures[NodeIndex]); It; ++It)
+		{
+			(RefCounts[It.GetIndex()] == 1 ? Cost.UniqueSize : Cost.SharedSize) += Graph->GetComponentSize(It.GetIndex());
+		}
+	}
+
+	for(TPair<FGuid, FHRFNodeCost>& Pair : Costs)
+	{
+		FHRFNodeCost& Cost = Pair.Value;
+		if(Cost.SharedSize == 0)
+		{
+			Cost.BadgeText = HardReferenceInternals::MakeBestSizeString(Cost.UniqueSize);
+		}
+		else if(Cost.UniqueSize == 0)
+		{
+			Cost.BadgeText = FText::Format(LOCTEXT("NodeCostShared", "{0} shared"), HardReferenceInternals::MakeBestSizeString(Cost.SharedSize));
+		}
+		else
+		{
+			Cost.BadgeText = FText::Format(LOCTEXT("NodeCostUniqueAndShared", "{0} (+{1} shared)"), HardReferenceInternals::MakeBestSizeString(Cost.UniqueSize), HardReferenceInternals::MakeBestSizeString(Cost.SharedSize));
+		}
+	}
+
+	if(Costs.Num() > 0)
+	{
+		const FSlateFontInfo Font = GetBadgeFont();
+		const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+		for(TPair<FGuid, FHRFNodeCost>& Pair : Costs)
+		{
+			Pair.Value.TextSize = FontMeasure->Measure(Pair.Value.BadgeText, Font);
+		}
+	}
+}
+
+void SHardReferenceFinderNodeCosts::Construct(const FArguments& InArgs, TSharedRef<SGraphPanel> InGraphPanel, TSharedRef<const FHRFNodeCosts> InCosts)
+{
+	GraphPanel = InGraphPanel;
+	Costs = InCosts;
+	SetVisibility(TAttribute<EVisibility>::CreateSP(this, &SHardReferenceFinderNodeCosts::GetOverlayVisibility));
+}
+
+void SHardReferenceFinderNodeCosts::SetCosts(TSharedRef<const FHRFNodeCosts> InCosts)
+{
+	Costs = InCosts;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SHardReferenceFinderNodeCosts::AttachToGraphPanels(const TSharedRef<SWidget>& Root, TSharedRef<const FHRFNodeCosts> Costs)
+{
+	using namespace HardReferenceNodeCostsInternals;
+
+	TArray<TSharedRef<SWidget>> Panels;
+	FindGraphPanels(Root, Panels);
+
+	for(const TSharedRef<SWidget>& Panel : Panels)
+	{
+		// Graph editors place the panel in an overlay along with the title bar and notifications
+		const TSharedPtr<SWidget> Parent = Panel->GetParentWidget();
+		if(!Parent.IsValid() || Parent->GetType() != OverlayType)
+		{
+			continue;
+		}
+
+		bool bIsAttached = false;
+		FChildren* Siblings = Parent->GetChildren();
+		for(int32 SiblingIndex = 0; SiblingIndex < Siblings->Num() && !bIsAttached; ++SiblingIndex)
+		{
+			const TSharedRef<SWidget> Sibling = Siblings->GetChildAt(SiblingIndex);
+			if(Sibling->GetType() == NodeCostsType)
+			{
+				StaticCastSharedRef<SHardReferenceFinderNodeCosts>(Sibling)->SetCosts(Costs);
+				bIsAttached = true;
+			}
+		}
+
+		if(!bIsAttached)
+		{
+			StaticCastSharedPtr<SOverlay>(Parent)->AddSlot()
+			[
+				SNew(SHardReferenceFinderNodeCosts, StaticCastSharedRef<SGraphPanel>(Panel), Costs)
+			];
+		}
+	}
+}
+
+int32 SHardReferenceFinderNodeCosts::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	using namespace HardReferenceNodeCostsInternals;
+
+	const TSharedPtr<SGraphPanel> Panel = GraphPanel.Pin();
+	const TSharedPtr<const FHRFNodeCosts> PinnedCosts = Costs.Pin();
+	if(!Panel.IsValid() || !PinnedCosts.IsValid() || PinnedCosts->Costs.Num() == 0 || Panel->GetZoomAmount() < MinBadgeZoom)
+	{
+		return LayerId;
+	}
+
+	const FGeometry& PanelGeometry = Panel->GetTickSpaceGeometry();
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	const FSlateFontInfo Font = GetBadgeFont();
+	const FSlateBrush* Brush = GetBrush_Badge();
+	const FLinearColor BadgeColor = FLinearColor(0.f, 0.f, 0.f, 0.75f) * InWidgetStyle.GetColorAndOpacityTint();
+	const FLinearColor TextColor = FLinearColor(1.f, 0.8f, 0.3f) * InWidgetStyle.GetColorAndOpacityTint();
+
+	// Only nodes listed in the results are visited, the rest of the graph costs nothing to draw
+	for(const TPair<FGuid, FHRFNodeCost>& Pair : PinnedCosts->Costs)
+	{
+		const auto NodeWidget = Panel->GetNodeWidgetFromGuid(Pair.Key);
+		if(!NodeWidget.IsValid())
+		{
+			continue;
+		}
+
+		const FVector2D PanelPosition = Panel->GraphCoordToPanelCoord(FVector2D(NodeWidget->GetPosition()));
+		const FVector2D NodePosition = AllottedGeometry.AbsoluteToLocal(PanelGeometry.LocalToAbsolute(PanelPosition));
+		const FVector2D& TextSize = Pair.Value.TextSize;
+		const FVector2D BadgeSize = TextSize + BadgePadding * 2.f;
+		const FVector2D BadgePosition = NodePosition - FVector2D(0.f, BadgeSize.Y + 2.f);
+		if(BadgePosition.X > LocalSize.X || BadgePosition.Y > LocalSize.Y || BadgePosition.X + BadgeSize.X < 0.f || BadgePosition.Y + BadgeSize.Y < 0.f)
+		{
+			continue;
+		}
+
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(BadgeSize, FSlateLayoutTransform(BadgePosition)), Brush, ESlateDrawEffect::None, BadgeColor);
+		FSlateDrawElement::MakeText(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(TextSize, FSlateLayoutTransform(BadgePosition + BadgePadding)), Pair.Value.BadgeText, Font, ESlateDrawEffect::None, TextColor);
+	}
+	return LayerId + 2;
+}
+
+FVector2D SHardReferenceFinderNodeCosts::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Fills whatever the overlay gives it without affecting the graph's layout
+	return FVector2D::ZeroVector;
+}
+
+EVisibility SHardReferenceFinderNodeCosts::GetOverlayVisibility() const
+{
+	const TSharedPtr<const FHRFNodeCosts> PinnedCosts = Costs.Pin();
+	return PinnedCosts.IsValid() && PinnedCosts->bVisible ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+}
+
+const FSlateBrush* SHardReferenceFinderNodeCosts::GetBrush_Badge() const
+{
+	return FCoreStyle::Get().GetBrush("WhiteBrush");
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,49 @@
+#include "SHardReferenceFinderSparkline.h"
+#include "Rendering/DrawElements.h"
+
+void SHardReferenceFinderSparkline::Construct(const FArguments& InArgs)
+{
+	DesiredSize = InArgs._DesiredSize;
+	LineColor = InArgs._LineColor;
+}
+
+void SHardReferenceFinderSparkline::SetValues(TArray<double>&& InValues)
+{
+	Values = MoveTemp(InValues);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SHardReferenceFinderSparkline::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	if(Values.Num() < 2)
+	{
+		return LayerId;
+	}
+
+	double MinValue = Values[0];
+	double MaxValue = Values[0];
+	for(const double Value : Values)
+	{
+		MinValue = FMath::Min(MinValue, Value);
+		MaxValue = FMath::Max(MaxValue, Value);
+	}
+
+	// A flat history is drawn through the middle rather than along an edge
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+	const double Range = MaxValue - MinValue;
+	TArray<FVector2D> Points;
+	Points.Reserve(Values.Num());
+	for(int32 ValueIndex = 0; ValueIndex < Values.Num(); ++ValueIndex)
+	{
+		const double Alpha = Range > 0.0 ? (Values[ValueIndex] - MinValue) / Range : 0.5;
+		Points.Emplace(Size.X * ValueIndex / (Values.Num() - 1), (Size.Y - 2.0) * (1.0 - Alpha) + 1.0);
+	}
+
+	FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Points, ESlateDrawEffect::None, LineColor * InWidgetStyle.GetColorAndOpacityTint(), true, 1.5f);
+	return LayerId + 1;
+}
+
+FVector2D SHardReferenceFinderSparkline::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return DesiredSize;
+}
@@ -2,14 +2,37 @@
 #include "SHardReferenceFinderWindow.h"
 #include "BlueprintEditor.h"
 #include "BlueprintEditorTabs.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
 #include "GraphEditorSettings.h"
+#include "HardReferenceFinderCache.h"
+#include "HardReferenceFinderCookedRegistry.h"
+#include "HardReferenceFinderDependencyGraph.h"
+#include "HardReferenceFinderFilter.h"
+#include "HardReferenceFinderMemory.h"
 #include "HardReferenceFinderSearchData.h"
+#include "HardReferenceFinderTextUtils.h"
+#include "HardReferenceFinderTrendStore.h"
+#include "SHardReferenceFinderNodeCosts.h"
+#include "SHardReferenceFinderSparkline.h"
+#include "Editor.h"
+#include "Engine/LevelScriptBlueprint.h"
+#include "GameFramework/Actor.h"
 #include "Engine/SCS_Node.h"
 #include "Engine/SimpleConstructionScript.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Misc/MessageDialog.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Docking/SDockTab.h"
 
 #if UE_VERSION_OLDER_THAN(5, 1, 0)
 #include "EditorStyleSet.h"
@@ -19,33 +42,95 @@
 
 namespace HardReferenceInternals
 {
-	static FText MakeBestSizeString(const SIZE_T SizeInBytes)
+	static FSlateColor GetDiffColor(const EHRFDiffState DiffState)
 	{
-		FText SizeText;
-
-		if (SizeInBytes < 1000)
+		switch(DiffState)
 		{
-			// We ended up with bytes, so show a decimal number
-			SizeText = FText::AsMemory(SizeInBytes, EMemoryUnitStandard::SI);
+		case EHRFDiffState::Added:
+			return FLinearColor(0.3f, 0.85f, 0.3f);
+		case EHRFDiffState::Removed:
+			return FLinearColor(0.9f, 0.3f, 0.3f);
+		case EHRFDiffState::Changed:
+			return FLinearColor(0.95f, 0.75f, 0.2f);
+		default:
+			return FSlateColor::UseForeground();
 		}
-		else
+	}
+
+	static const TCHAR* SnapshotFileTypes = TEXT("Hard Reference Snapshot (*.hrfsnap)|*.hrfsnap");
+	static const TCHAR* ResultsFileTypes = TEXT("Hard Reference Results (*.hrfsnap;*.hrfaudit)|*.hrfsnap;*.hrfaudit");
+
+	// Number of alternative reference chains listed when explaining why a package is referenced
+	static const int32 MaxExplainedPaths = 5;
+
+	// Number of headers stored with each history sample, and of regressions listed from the history
+	static const int32 MaxHistoryTopHeaders = 5;
+	static const int32 MaxHistoryRegressions = 5;
+
+	// How often graphs opened while node costs are shown are checked for, in seconds
+	static const float NodeCostsAttachPeriod = 1.f;
+
+	// A tab is only shown when it's in front of its stack, and so is every major tab hosting it
+	static bool IsTabShown(const TSharedRef<SDockTab>& Tab)
+	{
+		if(!Tab->IsForeground())
 		{
-			// Show a fractional number with the best possible units
-			FNumberFormattingOptions NumberFormattingOptions;
-			NumberFormattingOptions.MaximumFractionalDigits = 1;
-			NumberFormattingOptions.MinimumFractionalDigits = 0;
-			NumberFormattingOptions.MinimumIntegralDigits = 1;
+			return false;
+		}
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		const TSharedPtr<FTabManager> TabManager = Tab->GetTabManager();
+#else
+		const TSharedPtr<FTabManager> TabManager = Tab->GetTabManagerPtr();
+#endif
+		const TSharedPtr<SDockTab> HostTab = TabManager.IsValid() ? TabManager->GetOwnerTab() : nullptr;
+		return !HostTab.IsValid() || HostTab == Tab || IsTabShown(HostTab.ToSharedRef());
+	}
 
-			SizeText = FText::AsMemory(SizeInBytes, &NumberFormattingOptions, nullptr, EMemoryUnitStandard::SI);
+	// Search results are shared with other windows, so they're copied before being marked up
+	static TArray<FHRFTreeViewItemPtr> CopyResults(const TArray<FHRFTreeViewItemPtr>& Results)
+	{
+		TArray<FHRFTreeViewItemPtr> Copies;
+		Copies.Reserve(Results.Num());
+		for(const FHRFTreeViewItemPtr& Item : Results)
+		{
+			const FHRFTreeViewItemPtr Copy = MakeShared<FHRFTreeViewItem>(*Item);
+			Copy->Children = CopyResults(Item->Children);
+			Copies.Add(Copy);
 		}
+		return Copies;
+	}
 
-		return SizeText;
-	}	
+	static FText MakeMillisecondsString(double Seconds)
+	{
+		FNumberFormattingOptions Options;
+		Options.MaximumFractionalDigits = 1;
+		return FText::Format(LOCTEXT("Milliseconds", "{0} ms"), FText::AsNumber(Seconds * 1000.0, &Options));
+	}
+}
+
+SHardReferenceFinderWindow::~SHardReferenceFinderWindow()
+{
+	// Tabs can outlive the module when the editor shuts down
+	if(FHardReferenceFinderScheduler* Scheduler = FHardReferenceFinderScheduler::TryGet())
+	{
+		Scheduler->CancelSearches(this);
+	}
+	FEditorDelegates::OnMapOpened.RemoveAll(this);
 }
 
 void SHardReferenceFinderWindow::Construct(const FArguments& InArgs, TSharedPtr<FBlueprintEditor> InBlueprintGraph)
 {
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
 	BlueprintGraph = InBlueprintGraph;
+	bAnalyzeEditorWorld = InArgs._AnalyzeEditorWorld;
+	AnalyzedAsset = InArgs._Asset;
+	NodeCosts = MakeShared<FHRFNodeCosts>();
+	RefreshSizePlatforms();
+	LoadTrace.OnTraceFinished.BindSP(this, &SHardReferenceFinderWindow::OnLoadTraceFinished);
+	if(bAnalyzeEditorWorld)
+	{
+		FEditorDelegates::OnMapOpened.AddSP(this, &SHardReferenceFinderWindow::OnMapOpened);
+	}
 	
 	ChildSlot[
 		SNew(SVerticalBox)
@@ -62,6 +147,61 @@ void SHardReferenceFinderWindow::Construct(const FArguments& InArgs, TSharedPtr<
 			]
 			+SHorizontalBox::Slot()
 			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(0.f, 0.0f, 8.f, 0.f)
+			[
+				SAssignNew(HistorySparkline, SHardReferenceFinderSparkline)
+				.ToolTipText(LOCTEXT("HistorySparklineTooltip", "Closure size of this asset each time its references changed"))
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.Padding(0.f, 0.0f, 8.f, 0.f)
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SHardReferenceFinderWindow::GetCheckState_SoftReferences)
+				.OnCheckStateChanged(this, &SHardReferenceFinderWindow::OnSoftReferencesChanged)
+				.ToolTipText(LOCTEXT("SoftReferencesTooltip", "Also list packages this asset soft references, with the size loaded when each one is resolved. Soft references to packages in the hard closure are marked, they load nothing extra."))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("SoftReferences", "Soft References"))
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.Padding(0.f, 0.0f, 8.f, 0.f)
+			[
+				SNew(SCheckBox)
+				.Visibility(this, &SHardReferenceFinderWindow::GetVisibility_NodeCosts)
+				.IsChecked(this, &SHardReferenceFinderWindow::GetCheckState_NodeCosts)
+				.OnCheckStateChanged(this, &SHardReferenceFinderWindow::OnNodeCostsChanged)
+				.ToolTipText(LOCTEXT("NodeCostsTooltip", "Draw the size each node hard references above it in this blueprint's graphs. Shared sizes are packages other sources reference too."))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("NodeCosts", "Costs on Nodes"))
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.Padding(0.f, 0.0f, 4.f, 0.f)
+			[
+				SAssignNew(SizePlatformCombo, SComboBox<TSharedPtr<FName>>)
+				.OptionsSource(&SizePlatforms)
+				.OnComboBoxOpening(this, &SHardReferenceFinderWindow::RefreshSizePlatforms)
+				.OnSelectionChanged(this, &SHardReferenceFinderWindow::OnSizePlatformChanged)
+				.OnGenerateWidget(this, &SHardReferenceFinderWindow::OnGenerateSizePlatformWidget)
+				.ToolTipText(LOCTEXT("SizePlatformTooltip", "Show the sizes of packages as cooked for a platform rather than the size of the editor assets. Platforms are listed once they have been cooked."))
+				[
+					SNew(STextBlock)
+					.Text(this, &SHardReferenceFinderWindow::GetText_SizePlatform)
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
 			.HAlign(HAlign_Right)
 			.Padding(0.f, 0.0f)
 			[
@@ -88,6 +228,76 @@ void SHardReferenceFinderWindow::Construct(const FArguments& InArgs, TSharedPtr<
 					]
 				]
 			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.Padding(4.f, 0.0f, 0.f, 0.f)
+			[
+				SNew(SButton)
+				.OnClicked(this, &SHardReferenceFinderWindow::OnSaveSnapshotClicked)
+				.ToolTipText(LOCTEXT("SaveSnapshotTooltip", "Save the current results so a later revision of this blueprint can be compared against them."))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("SaveSnapshot", "Save Snapshot"))
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.Padding(4.f, 0.0f, 0.f, 0.f)
+			[
+				SNew(SButton)
+				.OnClicked(this, &SHardReferenceFinderWindow::OnCompareClicked)
+				.ToolTipText(LOCTEXT("CompareTooltip", "Compare the current results against a saved snapshot, highlighting added and removed packages and size changes."))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("Compare", "Compare..."))
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.Padding(4.f, 0.0f, 0.f, 0.f)
+			[
+				SNew(SButton)
+				.Visibility(this, &SHardReferenceFinderWindow::GetVisibility_Trace)
+				.OnClicked(this, &SHardReferenceFinderWindow::OnTraceClicked)
+				.ToolTipText(LOCTEXT("TraceTooltip", "Record which packages the next Play In Editor session loads, and compare them against these results once it ends."))
+				[
+					SNew(STextBlock)
+					.Text(this, &SHardReferenceFinderWindow::GetText_Trace)
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.HAlign(HAlign_Right)
+			.Padding(4.f, 0.0f, 0.f, 0.f)
+			[
+				SNew(SButton)
+				.Visibility(this, &SHardReferenceFinderWindow::GetVisibility_ClearDiff)
+				.OnClicked(this, &SHardReferenceFinderWindow::OnClearDiffClicked)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ClearDiff", "Clear Diff"))
+				]
+			]
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(18.f, 0.f, 10.f, 8.f)
+		[
+			SNew(SEditableTextBox)
+			.HintText(LOCTEXT("ExplainPathHint", "Explain why a package is referenced, e.g. /Game/Cinematics/Intro"))
+			.ToolTipText(LOCTEXT("ExplainPathTooltip", "Lists the shortest chains of hard references leading to this package, starting from the source that makes the first reference."))
+			.OnTextCommitted(this, &SHardReferenceFinderWindow::OnExplainPathCommitted)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(18.f, 0.f, 10.f, 8.f)
+		[
+			SNew(SSearchBox)
+			.HintText(LOCTEXT("FilterHint", "Filter by package, asset class or source. -word excludes, \"word\" matches whole words."))
+			.OnTextChanged(this, &SHardReferenceFinderWindow::OnFilterTextChanged)
 		]
 		+ SVerticalBox::Slot()
 		[
@@ -112,36 +322,148 @@ TSet<FName> SHardReferenceFinderWindow::GetCollapsedPackages() const
 	TSet<FHRFTreeViewItemPtr> ExpandedItems;
 	TreeView->GetExpandedItems(ExpandedItems);
 
-	TSet<FName> CollapsedPackages;
+	// Items hidden by the filter keep the state they had when they were last shown
+	TSet<FName> CollapsedPackages = FilteredCollapsedPackages;
 	for(const FHRFTreeViewItemPtr Item : TreeViewData)
 	{
 		if(!ExpandedItems.Contains(Item))
 		{
 			CollapsedPackages.Add(Item->PackageId);
 		}
+		else
+		{
+			CollapsedPackages.Remove(Item->PackageId);
+		}
 	}
 	return CollapsedPackages;
 }
 
+void SHardReferenceFinderWindow::SetOwnerTab(const TSharedRef<SDockTab>& InOwnerTab)
+{
+	OwnerTab = InOwnerTab;
+}
+
 void SHardReferenceFinderWindow::InitiateSearch()
 {
+	FHRFSearchRequest Request;
+	if(bAnalyzeEditorWorld)
+	{
+		Request.Target = EHRFSearchTarget::World;
+		Request.Object = GetEditorWorld();
+	}
+	else if(AnalyzedAsset.IsValid())
+	{
+		Request.Target = EHRFSearchTarget::Asset;
+		Request.Object = AnalyzedAsset;
+	}
+	else
+	{
+		Request.Target = EHRFSearchTarget::Blueprint;
+		Request.Object = GetSearchedBlueprint();
+		Request.BlueprintEditor = BlueprintGraph;
+	}
+	Request.SizePlatform = SizePlatform;
+	Request.bIncludeSoftReferences = bIncludeSoftReferences;
+
+	// Runs once this window can be seen, along with every other window waiting on the same search
+	FHardReferenceFinderScheduler::Get().RequestSearch(this, Request,
+		FOnHRFGetSearchPriority::CreateSP(this, &SHardReferenceFinderWindow::GetSearchPriority),
+		FOnHRFSearchFinished::CreateSP(this, &SHardReferenceFinderWindow::OnSearchFinished));
+	if(!LastSearch.IsValid())
+	{
+		HeaderText->SetText(LOCTEXT("SearchPending", "Searching for hard references..."));
+	}
+}
+
+EHRFSearchPriority SHardReferenceFinderWindow::GetSearchPriority() const
+{
+	const TSharedPtr<SDockTab> PinnedOwnerTab = OwnerTab.Pin();
+	if(!PinnedOwnerTab.IsValid())
+	{
+		return EHRFSearchPriority::Visible;
+	}
+	if(!HardReferenceInternals::IsTabShown(PinnedOwnerTab.ToSharedRef()))
+	{
+		return EHRFSearchPriority::Hidden;
+	}
+	return PinnedOwnerTab->IsActive() ? EHRFSearchPriority::Focused : EHRFSearchPriority::Visible;
+}
+
+void SHardReferenceFinderWindow::OnSearchFinished(TSharedRef<const FHRFSearchOutcome> Outcome)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	LastSearch = Outcome;
 	if(TreeView.IsValid())
 	{
 		TSet<FName> UserCollapsedPackages = GetCollapsedPackages();
 
-		TreeViewData = SearchData.GatherSearchData(BlueprintGraph);
-		TreeView->RebuildList();
-
-		// expand new items by default, unless they were intentionally collapsed.
-		for(const FHRFTreeViewItemPtr Item : TreeViewData)
+		SearchResults = Outcome->Results;
+		if(DiffBaseline.IsValid() && DiffBaseline.GetBlueprintPackage() != GetSearchedPackageName())
+		{
+			// The level tab follows the open map, a baseline of the previous map no longer applies
+			DiffBaseline = FHardReferenceFinderSnapshot();
+		}
+		if(DiffBaseline.IsValid())
+		{
+			SearchResults = HardReferenceInternals::CopyResults(SearchResults);
+			DiffBaseline.ApplyDiff(SearchResults);
+		}
+		NodeCosts->SetResults(SearchResults);
+		if(NodeCosts->bVisible)
 		{
-			const bool bWasCollapsed = UserCollapsedPackages.Contains(Item->PackageId);
-			const bool bShouldExpandItem = !bWasCollapsed;	
-			TreeView->SetItemExpansion(Item, bShouldExpandItem);
+			AttachNodeCosts(0.0, 0.f);
 		}
+		AddPathExplanation();
+		AddLoadTrace();
+		RecordHistory();
+		AddHistory();
+		Filter.Reset();
+		ApplyFilter(UserCollapsedPackages);
 	}
 	
-	const FText SummaryText = FText::Format(LOCTEXT("SummaryMessage", "This blueprint makes {0} references to other packages."), SearchData.GetNumPackagesReferenced());
+	FText SummaryText = FText::Format(LOCTEXT("SummaryMessage", "This blueprint makes {0} references to other packages."), Outcome->NumPackagesReferenced);
+	if(bAnalyzeEditorWorld)
+	{
+		SummaryText = FText::Format(LOCTEXT("LevelSummaryMessage", "This level makes {0} references to other packages."), Outcome->NumPackagesReferenced);
+	}
+	else if(AnalyzedAsset.IsValid())
+	{
+		SummaryText = FText::Format(LOCTEXT("AssetSummaryMessage", "This asset makes {0} references to other packages."), Outcome->NumPackagesReferenced);
+	}
+	if(Outcome->NumSoftPackagesReferenced > 0)
+	{
+		SummaryText = FText::Format(LOCTEXT("SoftSummaryMessage", "{0} It also soft references {1} packages."), SummaryText, Outcome->NumSoftPackagesReferenced);
+	}
+	if(Outcome->bUsingCookedSizes)
+	{
+		SummaryText = FText::Format(LOCTEXT("CookedSizesSummaryMessage", "{0}\nSizes are cooked sizes for {1}."), SummaryText, FText::FromName(Outcome->SizePlatform));
+		if(!Outcome->OwnChunkList.IsEmpty())
+		{
+			SummaryText = FText::Format(LOCTEXT("ForeignChunkSummaryMessage", "{0} It is in chunks {1} and pulls in {2} from other chunks."), SummaryText, FText::FromString(Outcome->OwnChunkList), HardReferenceInternals::MakeBestSizeString(Outcome->ForeignChunkSize));
+		}
+	}
+	else if(!Outcome->SizePlatform.IsNone())
+	{
+		SummaryText = FText::Format(LOCTEXT("MissingCookSummaryMessage", "{0}\nNo cooked asset registry was found for {1}, showing editor sizes."), SummaryText, FText::FromName(Outcome->SizePlatform));
+	}
+	if(DiffBaseline.IsValid())
+	{
+		int32 NumAdded = 0;
+		int32 NumRemoved = 0;
+		for(const FHRFTreeViewItemPtr& Item : SearchResults)
+		{
+			NumAdded += Item->DiffState == EHRFDiffState::Added ? 1 : 0;
+			NumRemoved += Item->DiffState == EHRFDiffState::Removed ? 1 : 0;
+		}
+		SummaryText = FText::Format(LOCTEXT("DiffSummaryMessage", "{0}\nCompared to snapshot: {1} added, {2} removed."), SummaryText, NumAdded, NumRemoved);
+
+		// Header closures overlap, so only the searched asset's own closure tells how much the total changed
+		if(DiffBaseline.GetClosureSize() > 0 && Outcome->SearchedClosure.IsValid())
+		{
+			const int64 ClosureDelta = Outcome->SearchedClosure->TotalSize - DiffBaseline.GetClosureSize();
+			SummaryText = FText::Format(LOCTEXT("DiffClosureSummaryMessage", "{0} Total closure {1}."), SummaryText, HardReferenceInternals::MakeSizeDeltaString(ClosureDelta));
+		}
+	}
 	HeaderText->SetText(SummaryText);
 }
 
@@ -151,6 +473,706 @@ FReply SHardReferenceFinderWindow::OnRefreshClicked()
 	return FReply::Handled();
 }
 
+FReply SHardReferenceFinderWindow::OnSaveSnapshotClicked()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if(DesktopPlatform == nullptr)
+	{
+		return FReply::Handled();
+	}
+
+	const FName BlueprintPackageName = GetSearchedPackageName();
+	const FString DefaultFileName = FPaths::GetCleanFilename(BlueprintPackageName.ToString()) + TEXT(".hrfsnap");
+
+	TArray<FString> OutFileNames;
+	const void* ParentWindowHandle = FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared());
+	const bool bPicked = DesktopPlatform->SaveFileDialog(ParentWindowHandle, LOCTEXT("SaveSnapshotTitle", "Save Hard Reference Snapshot").ToString(), FPaths::ProjectSavedDir(), DefaultFileName, HardReferenceInternals::SnapshotFileTypes, EFileDialogFlags::None, OutFileNames);
+	if(bPicked && OutFileNames.Num() > 0)
+	{
+		const int64 ClosureSize = LastSearch.IsValid() && LastSearch->SearchedClosure.IsValid() ? LastSearch->SearchedClosure->TotalSize : 0;
+		const FHardReferenceFinderSnapshot Snapshot = FHardReferenceFinderSnapshot::FromSearchResults(BlueprintPackageName, SearchResults, ClosureSize);
+		if(!Snapshot.SaveToFile(OutFileNames[0]))
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("SaveSnapshotFailed", "Failed to save the snapshot to {0}. Check that the folder exists and the file isn't read-only."), FText::FromString(OutFileNames[0])));
+		}
+	}
+	return FReply::Handled();
+}
+
+FReply SHardReferenceFinderWindow::OnCompareClicked()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if(DesktopPlatform == nullptr)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FString> OutFileNames;
+	const void* ParentWindowHandle = FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared());
+	const bool bPicked = DesktopPlatform->OpenFileDialog(ParentWindowHandle, LOCTEXT("CompareSnapshotTitle", "Compare Against Snapshot").ToString(), FPaths::ProjectSavedDir(), TEXT(""), HardReferenceInternals::ResultsFileTypes, EFileDialogFlags::None, OutFileNames);
+	if(bPicked && OutFileNames.Num() > 0)
+	{
+		// Comparing against another blueprint's snapshot would mark every package as added or removed
+		const FName SearchedPackage = GetSearchedPackageName();
+		FHardReferenceFinderSnapshot Snapshot;
+		if(!Snapshot.LoadFromFile(OutFileNames[0], SearchedPackage))
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("LoadSnapshotFailed", "{0} is not a hard reference snapshot, or it holds no results for {1}."), FText::FromString(OutFileNames[0]), FText::FromName(SearchedPackage)));
+		}
+		else if(Snapshot.GetBlueprintPackage() != SearchedPackage)
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("SnapshotPackageMismatch", "This snapshot was saved for {0} and can't be compared against {1}."), FText::FromName(Snapshot.GetBlueprintPackage()), FText::FromName(SearchedPackage)));
+		}
+		else
+		{
+			DiffBaseline = MoveTemp(Snapshot);
+			InitiateSearch();
+		}
+	}
+	return FReply::Handled();
+}
+
+FReply SHardReferenceFinderWindow::OnClearDiffClicked()
+{
+	DiffBaseline = FHardReferenceFinderSnapshot();
+	InitiateSearch();
+	return FReply::Handled();
+}
+
+void SHardReferenceFinderWindow::OnExplainPathCommitted(const FText& Text, ETextCommit::Type CommitType)
+{
+	if(CommitType != ETextCommit::OnEnter && CommitType != ETextCommit::OnCleared)
+	{
+		return;
+	}
+
+	const FString PackageName = Text.ToString().TrimStartAndEnd();
+	ExplainedPackage = CommitType == ETextCommit::OnCleared || PackageName.IsEmpty() ? NAME_None : FName(*PackageName);
+	InitiateSearch();
+}
+
+void SHardReferenceFinderWindow::RefreshSizePlatforms()
+{
+	SizePlatforms.Reset();
+	SizePlatforms.Add(MakeShared<FName>(NAME_None));
+	for(const FName& Platform : FHardReferenceFinderCookedRegistry::FindCookedPlatforms())
+	{
+		SizePlatforms.Add(MakeShared<FName>(Platform));
+	}
+	if(SizePlatformCombo.IsValid())
+	{
+		SizePlatformCombo->RefreshOptions();
+	}
+}
+
+void SHardReferenceFinderWindow::OnSizePlatformChanged(TSharedPtr<FName> NewPlatform, ESelectInfo::Type SelectInfo)
+{
+	if(NewPlatform.IsValid() && *NewPlatform != SizePlatform)
+	{
+		SizePlatform = *NewPlatform;
+		InitiateSearch();
+	}
+}
+
+TSharedRef<SWidget> SHardReferenceFinderWindow::OnGenerateSizePlatformWidget(TSharedPtr<FName> Platform) const
+{
+	return SNew(STextBlock).Text(GetSizePlatformText(Platform.IsValid() ? *Platform : NAME_None));
+}
+
+FText SHardReferenceFinderWindow::GetSizePlatformText(FName Platform) const
+{
+	if(Platform.IsNone())
+	{
+		return LOCTEXT("EditorSizes", "Editor Sizes");
+	}
+	return FText::Format(LOCTEXT("CookedSizes", "Cooked: {0}"), FText::FromName(Platform));
+}
+
+FText SHardReferenceFinderWindow::GetText_SizePlatform() const
+{
+	return GetSizePlatformText(SizePlatform);
+}
+
+void SHardReferenceFinderWindow::AddPathExplanation()
+{
+	if(ExplainedPackage.IsNone())
+	{
+		return;
+	}
+
+	// The first explanation builds the dependency graph, which takes a while on large projects
+	FScopedSlowTask SlowTask(2.f, FText::Format(LOCTEXT("ExplainingReference", "Finding the hard reference chains to {0}..."), FText::FromName(ExplainedPackage)));
+	SlowTask.MakeDialogDelayed(1.f);
+
+	SlowTask.EnterProgressFrame();
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	const int32 FromPackage = Graph->FindPackage(GetSearchedPackageName());
+	const int32 ToPackage = Graph->FindPackage(ExplainedPackage);
+	SlowTask.EnterProgressFrame();
+
+	FHRFTreeViewItemPtr Header = MakeShared<FHRFTreeViewItem>();
+	Header->bIsHeader = true;
+	Header->Name = FText::Format(LOCTEXT("PathHeader", "Why is {0} referenced?"), FText::FromString(FPaths::GetCleanFilename(ExplainedPackage.ToString())));
+	Header->Tooltip = FText::FromName(ExplainedPackage);
+	Header->SlateIcon = FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer");
+
+	TArray<TArray<int32>> Paths;
+	if(FromPackage != INDEX_NONE && ToPackage != INDEX_NONE)
+	{
+		Header->SizeOnDisk = Graph->GetClosureSize(ToPackage);
+		if(FromPackage == ToPackage)
+		{
+			// The only chain would be the package on its own, which explains nothing
+			FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+			Child->Name = LOCTEXT("PathToSelf", "This is the package being searched");
+			Header->Children.Add(Child);
+		}
+		else
+		{
+			Paths = Graph->FindShortestPaths(FromPackage, ToPackage, HardReferenceInternals::MaxExplainedPaths);
+		}
+	}
+
+	if(Paths.Num() == 0 && Header->Children.Num() == 0)
+	{
+		FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+		Child->Name = LOCTEXT("NoPathFound", "No chain of hard references leads to this package");
+		Header->Children.Add(Child);
+	}
+
+	for(const TArray<int32>& Path : Paths)
+	{
+		FString PathString;
+		FString PathTooltip;
+		for(int32 PathIndex = 1; PathIndex < Path.Num(); ++PathIndex)
+		{
+			const FString PathPackageName = Graph->GetPackageName(Path[PathIndex]).ToString();
+			PathString += (PathIndex > 1 ? TEXT(" > ") : TEXT("")) + FPaths::GetCleanFilename(PathPackageName);
+			PathTooltip += (PathIndex > 1 ? TEXT("\n") : TEXT("")) + PathPackageName;
+		}
+
+		FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+		Child->Name = FText::FromString(PathString);
+		Child->Tooltip = FText::FromString(PathTooltip);
+		Child->SlateIcon = FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer");
+		Header->Children.Add(Child);
+
+		// The first hop is a direct dependency, link the chain to whatever in this asset makes that reference
+		const FName FirstHop = Path.Num() > 1 ? Graph->GetPackageName(Path[1]) : NAME_None;
+		const FHRFTreeViewItemPtr* FirstHopHeader = SearchResults.FindByPredicate([FirstHop](const FHRFTreeViewItemPtr& Item)
+		{
+			return Item->bIsHeader && !Item->bIsSoftReference && Item->PackageId == FirstHop;
+		});
+		// Link the first source that was actually identified, the placeholder has nothing to navigate to
+		const FHRFTreeViewItemPtr* FirstSource = FirstHopHeader ? (*FirstHopHeader)->Children.FindByPredicate([](const FHRFTreeViewItemPtr& Item)
+		{
+			return !Item->bIsUnidentifiedSource;
+		}) : nullptr;
+		if(FirstSource)
+		{
+			const FHRFTreeViewItemPtr& Source = *FirstSource;
+			Source->ResolveDisplayInfo();
+			Child->Name = FText::Format(LOCTEXT("PathWithSource", "{0} > {1}"), Source->Name, Child->Name);
+			Child->NodeGuid = Source->NodeGuid;
+			Child->SCSIdentifier = Source->SCSIdentifier;
+			Child->SourceObject = Source->SourceObject;
+		}
+	}
+
+	SearchResults.Insert(Header, 0);
+}
+
+FReply SHardReferenceFinderWindow::OnTraceClicked()
+{
+	if(LoadTrace.IsArmed())
+	{
+		LoadTrace.Disarm();
+	}
+	else if(const UClass* TracedClass = GetTracedActorClass())
+	{
+		LoadTrace.Arm(TracedClass);
+	}
+	return FReply::Handled();
+}
+
+void SHardReferenceFinderWindow::OnLoadTraceFinished(const TArray<FHRFLoadEvent>& Events, int32 NumDropped)
+{
+	TraceEvents = Events;
+	NumDroppedTraceEvents = NumDropped;
+	InitiateSearch();
+}
+
+void SHardReferenceFinderWindow::AddLoadTrace()
+{
+	if(TraceEvents.Num() == 0)
+	{
+		return;
+	}
+
+	// A synchronous load ends when its first asset finishes loading, loads without a start were asynchronous
+	TMap<FName, double> SyncLoadStarts;
+	TMap<FName, double> LoadTimes;
+	double FirstSpawnTime = TNumericLimits<double>::Max();
+	for(const FHRFLoadEvent& Event : TraceEvents)
+	{
+		switch(Event.Type)
+		{
+		case EHRFLoadEventType::SyncLoadBegin:
+			SyncLoadStarts.FindOrAdd(Event.PackageName, Event.Time);
+			break;
+		case EHRFLoadEventType::Loaded:
+			LoadTimes.FindOrAdd(Event.PackageName, Event.Time);
+			break;
+		case EHRFLoadEventType::InstanceSpawned:
+			FirstSpawnTime = FMath::Min(FirstSpawnTime, Event.Time);
+			break;
+		}
+	}
+
+	// Loads nested inside another synchronous load are part of its stall, only the outermost ones are counted
+	struct FSyncLoad
+	{
+		FName PackageName;
+		double Start;
+		double End;
+	};
+	TArray<FSyncLoad> SyncLoads;
+	for(const TPair<FName, double>& Start : SyncLoadStarts)
+	{
+		if(const double* End = LoadTimes.Find(Start.Key))
+		{
+			SyncLoads.Add({Start.Key, Start.Value, FMath::Max(*End, Start.Value)});
+		}
+	}
+	SyncLoads.Sort([](const FSyncLoad& Lhs, const FSyncLoad& Rhs)
+	{
+		return Lhs.Start < Rhs.Start;
+	});
+	TMap<FName, double> StallTimes;
+	double OuterLoadEnd = TNumericLimits<double>::Lowest();
+	for(const FSyncLoad& SyncLoad : SyncLoads)
+	{
+		if(SyncLoad.Start >= OuterLoadEnd)
+		{
+			StallTimes.Add(SyncLoad.PackageName, SyncLoad.End - SyncLoad.Start);
+			OuterLoadEnd = SyncLoad.End;
+		}
+	}
+
+	const TSharedRef<const FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderCache::Get().GetDependencyGraph();
+	const auto GatherClosure = [&Graph](FName PackageName, TBitArray<>& OutClosure)
+	{
+		OutClosure.Init(false, Graph->NumComponents());
+		const int32 Package = Graph->FindPackage(PackageName);
+		if(Package != INDEX_NONE)
+		{
+			Graph->GatherClosureComponents(Package, OutClosure);
+		}
+	};
+	const auto IsInClosure = [&Graph](FName PackageName, const TBitArray<>& Closure)
+	{
+		const int32 Package = Graph->FindPackage(PackageName);
+		return Package != INDEX_NONE && Closure[Graph->GetComponent(Package)];
+	};
+
+	FHRFTreeViewItemPtr TraceHeader = MakeShared<FHRFTreeViewItem>();
+	TraceHeader->bIsHeader = true;
+	TraceHeader->Name = FText::Format(LOCTEXT("TraceHeader", "PIE load trace: {0} packages loaded"), LoadTimes.Num());
+	TraceHeader->Tooltip = LOCTEXT("TraceHeaderTooltip", "Packages loaded during the traced Play In Editor session. Packages the editor already had loaded are not loaded again and can't be observed.");
+	TraceHeader->SlateIcon = FSlateIcon("EditorStyle", "ContentBrowser.ReferenceViewer");
+
+	// Every load in the closure of a header counts towards it, so a package shared by two headers counts for both
+	struct FHeaderLoads
+	{
+		FHRFTreeViewItemPtr Header;
+		int32 NumLoaded = 0;
+		double StallTime = 0.0;
+	};
+	TArray<FHeaderLoads> HeaderLoads;
+	TMap<int32, TArray<int32, TInlineAllocator<1>>> HeadersOfPackage;
+	TBitArray<> HeaderClosures(false, Graph->NumComponents());
+	for(const FHRFTreeViewItemPtr& Header : SearchResults)
+	{
+		const int32 HeaderPackage = Header->PackageId.IsNone() || Header->DiffState == EHRFDiffState::Removed ? INDEX_NONE : Graph->FindPackage(Header->PackageId);
+		if(HeaderPackage != INDEX_NONE)
+		{
+			HeadersOfPackage.FindOrAdd(HeaderPackage).Add(HeaderLoads.Num());
+			HeaderLoads.AddDefaulted_GetRef().Header = Header;
+			Graph->GatherClosureComponents(HeaderPackage, HeaderClosures);
+		}
+	}
+
+	// Walking back from each load finds the headers whose closure contains it. Packages outside every header's
+	// closure can't lead to a header, so the walk never leaves the union of their closures.
+	TBitArray<> Visited(false, Graph->Num());
+	TArray<int32> VisitedPackages;
+	TArray<int32> Frontier;
+	for(const TPair<FName, double>& Load : LoadTimes)
+	{
+		const int32 LoadedPackage = Graph->FindPackage(Load.Key);
+		if(LoadedPackage == INDEX_NONE || !HeaderClosures[Graph->GetComponent(LoadedPackage)])
+		{
+			continue;
+		}
+
+		const double StallTime = StallTimes.FindRef(Load.Key);
+		Visited[LoadedPackage] = true;
+		VisitedPackages.Add(LoadedPackage);
+		Frontier.Add(LoadedPackage);
+		while(Frontier.Num() > 0)
+		{
+			const int32 Package = Frontier.Pop(false);
+			if(const TArray<int32, TInlineAllocator<1>>* Headers = HeadersOfPackage.Find(Package))
+			{
+				for(const int32 HeaderIndex : *Headers)
+				{
+					++HeaderLoads[HeaderIndex].NumLoaded;
+					HeaderLoads[HeaderIndex].StallTime += StallTime;
+				}
+			}
+
+			for(const int32 Referencer : Graph->GetReferencers(Package))
+			{
+				if(!Visited[Referencer] && HeaderClosures[Graph->GetComponent(Referencer)])
+				{
+					Visited[Referencer] = true;
+					VisitedPackages.Add(Referencer);
+					Frontier.Add(Referencer);
+				}
+			}
+		}
+
+		for(const int32 Package : VisitedPackages)
+		{
+			Visited[Package] = false;
+		}
+		VisitedPackages.Reset();
+	}
+	HeaderLoads.RemoveAll([](const FHeaderLoads& Loads)
+	{
+		return Loads.NumLoaded == 0;
+	});
+	HeaderLoads.Sort([](const FHeaderLoads& Lhs, const FHeaderLoads& Rhs)
+	{
+		return Lhs.StallTime > Rhs.StallTime;
+	});
+
+	for(const FHeaderLoads& Loads : HeaderLoads)
+	{
+		FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+		Child->Name = FText::Format(LOCTEXT("TraceHeaderLoads", "{0}: {1} packages loaded, {2} synchronous stall"), Loads.Header->Name, Loads.NumLoaded, HardReferenceInternals::MakeMillisecondsString(Loads.StallTime));
+		Child->Tooltip = Loads.Header->Tooltip;
+		Child->SlateIcon = Loads.Header->SlateIcon;
+		Child->IconColor = Loads.Header->IconColor;
+		TraceHeader->Children.Add(Child);
+	}
+
+	// Anything loaded once the asset was spawned that its static closure doesn't explain
+	TBitArray<> Closure;
+	GatherClosure(GetSearchedPackageName(), Closure);
+	for(const TPair<FName, double>& Load : LoadTimes)
+	{
+		if(IsInClosure(Load.Key, Closure))
+		{
+			TraceHeader->SizeOnDisk += Graph->GetDiskSize(Graph->FindPackage(Load.Key));
+		}
+	}
+
+	if(FirstSpawnTime == TNumericLimits<double>::Max())
+	{
+		FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+		Child->Name = LOCTEXT("TraceNoSpawn", "No instance of this blueprint was spawned during the session");
+		TraceHeader->Children.Add(Child);
+	}
+	else
+	{
+		for(const TPair<FName, double>& Load : LoadTimes)
+		{
+			if(Load.Value >= FirstSpawnTime && !IsInClosure(Load.Key, Closure))
+			{
+				FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+				Child->Name = FText::Format(LOCTEXT("TraceUnattributed", "Loaded after spawning, not hard referenced: {0} ({1} stall)"), FText::FromName(Load.Key), HardReferenceInternals::MakeMillisecondsString(StallTimes.FindRef(Load.Key)));
+				Child->Tooltip = LOCTEXT("TraceUnattributedTooltip", "Likely a soft reference or a load made by other gameplay code after this blueprint was spawned");
+				TraceHeader->Children.Add(Child);
+			}
+		}
+	}
+
+	if(NumDroppedTraceEvents > 0)
+	{
+		FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+		Child->Name = FText::Format(LOCTEXT("TraceDropped", "{0} load events did not fit in the trace buffer and were dropped"), NumDroppedTraceEvents);
+		TraceHeader->Children.Add(Child);
+	}
+
+	SearchResults.Insert(TraceHeader, 0);
+}
+
+void SHardReferenceFinderWindow::RecordHistory()
+{
+	// Cooked sizes aren't comparable with the editor sizes the history is made of
+	const TSharedPtr<const FHRFClosureSize> SearchedClosure = LastSearch.IsValid() ? LastSearch->SearchedClosure : nullptr;
+	if(!SearchedClosure.IsValid() || LastSearch->bUsingCookedSizes)
+	{
+		return;
+	}
+
+	FHRFTrendSample Sample;
+	Sample.Timestamp = FDateTime::UtcNow().ToUnixTimestamp();
+	Sample.Changelist = FHardReferenceFinderTrendStore::GetCurrentChangelist();
+	Sample.TotalSize = SearchedClosure->TotalSize;
+	Sample.NumPackages = SearchedClosure->NumPackages;
+
+	TArray<FHRFTreeViewItemPtr> Headers = SearchResults.FilterByPredicate([](const FHRFTreeViewItemPtr& Item)
+	{
+		return !Item->PackageId.IsNone() && !Item->bIsSoftReference && Item->DiffState != EHRFDiffState::Removed;
+	});
+	Headers.Sort([](const FHRFTreeViewItemPtr& Lhs, const FHRFTreeViewItemPtr& Rhs)
+	{
+		return Lhs->SizeOnDisk > Rhs->SizeOnDisk;
+	});
+	for(int32 HeaderIndex = 0; HeaderIndex < FMath::Min(Headers.Num(), HardReferenceInternals::MaxHistoryTopHeaders); ++HeaderIndex)
+	{
+		Sample.TopHeaders.Emplace(Headers[HeaderIndex]->PackageId, Headers[HeaderIndex]->SizeOnDisk);
+	}
+
+	FHardReferenceFinderTrendStore::Get().Record(GetSearchedPackageName(), Sample);
+}
+
+void SHardReferenceFinderWindow::AddHistory()
+{
+	const FName SearchedPackage = GetSearchedPackageName();
+	if(SearchedPackage.IsNone())
+	{
+		HistorySparkline->SetVisibility(EVisibility::Collapsed);
+		return;
+	}
+
+	const TArray<FHRFTrendSample>& History = FHardReferenceFinderTrendStore::Get().GetHistory(SearchedPackage);
+
+	TArray<double> Sizes;
+	for(const FHRFTrendSample& Sample : History)
+	{
+		Sizes.Add(static_cast<double>(Sample.TotalSize));
+	}
+	HistorySparkline->SetValues(MoveTemp(Sizes));
+	HistorySparkline->SetVisibility(History.Num() > 1 ? EVisibility::Visible : EVisibility::Collapsed);
+
+	const TArray<int32> Regressions = FHardReferenceFinderTrendStore::FindBiggestRegressions(History, HardReferenceInternals::MaxHistoryRegressions);
+	if(Regressions.Num() == 0)
+	{
+		return;
+	}
+
+	FHRFTreeViewItemPtr HistoryHeader = MakeShared<FHRFTreeViewItem>();
+	HistoryHeader->bIsHeader = true;
+	HistoryHeader->Name = FText::Format(LOCTEXT("HistoryHeader", "Largest closure regressions over {0} recorded changes"), History.Num());
+	HistoryHeader->Tooltip = FText::FromString(FHardReferenceFinderTrendStore::GetStorePath());
+	HistoryHeader->SizeOnDisk = History.Last().TotalSize;
+	HistoryHeader->SlateIcon = FSlateIcon("EditorStyle", "ContentBrowser.SizeMap");
+
+	for(const int32 SampleIndex : Regressions)
+	{
+		const FHRFTrendSample& Before = History[SampleIndex - 1];
+		const FHRFTrendSample& After = History[SampleIndex];
+
+		// Headers that became one of the largest are the most likely cause of the jump
+		TArray<FString> NewTopHeaders;
+		for(const TPair<FName, int64>& TopHeader : After.TopHeaders)
+		{
+			const bool bWasTopHeader = Before.TopHeaders.ContainsByPredicate([&TopHeader](const TPair<FName, int64>& Other)
+			{
+				return Other.Key == TopHeader.Key;
+			});
+			if(!bWasTopHeader)
+			{
+				NewTopHeaders.Add(FPaths::GetCleanFilename(TopHeader.Key.ToString()));
+			}
+		}
+
+		FHRFTreeViewItemPtr Child = MakeShared<FHRFTreeViewItem>();
+		// Samples recorded without -HardReferenceChangelist= are only identified by when they were taken
+		FText When = FText::AsDateTime(FDateTime::FromUnixTimestamp(After.Timestamp));
+		if(After.Changelist > 0)
+		{
+			When = FText::Format(LOCTEXT("HistoryChangelist", "{0} (CL {1})"), When, FText::AsNumber(After.Changelist, &FNumberFormattingOptions::DefaultNoGrouping()));
+		}
+		Child->Name = FText::Format(LOCTEXT("HistoryRegression", "{0}: {1} to {2} [{3}]"),
+			When,
+			HardReferenceInternals::MakeBestSizeString(Before.TotalSize),
+			HardReferenceInternals::MakeBestSizeString(After.TotalSize),
+			HardReferenceInternals::MakeSizeDeltaString(After.TotalSize - Before.TotalSize));
+		if(NewTopHeaders.Num() > 0)
+		{
+			Child->Name = FText::Format(LOCTEXT("HistoryRegressionHeaders", "{0}, now referencing {1}"), Child->Name, FText::FromString(FString::Join(NewTopHeaders, TEXT(", "))));
+		}
+		Child->Tooltip = FText::Format(LOCTEXT("HistoryRegressionTooltip", "{0} packages before, {1} after"), Before.NumPackages, After.NumPackages);
+		Child->DiffState = EHRFDiffState::Added;
+		HistoryHeader->Children.Add(Child);
+	}
+
+	SearchResults.Add(HistoryHeader);
+}
+
+ECheckBoxState SHardReferenceFinderWindow::GetCheckState_SoftReferences() const
+{
+	return bIncludeSoftReferences ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SHardReferenceFinderWindow::OnSoftReferencesChanged(ECheckBoxState NewState)
+{
+	bIncludeSoftReferences = NewState == ECheckBoxState::Checked;
+	InitiateSearch();
+}
+
+ECheckBoxState SHardReferenceFinderWindow::GetCheckState_NodeCosts() const
+{
+	return NodeCosts->bVisible ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SHardReferenceFinderWindow::OnNodeCostsChanged(ECheckBoxState NewState)
+{
+	NodeCosts->bVisible = NewState == ECheckBoxState::Checked;
+	if(NodeCosts->bVisible)
+	{
+		NodeCosts->BuildIfNeeded();
+		AttachNodeCosts(0.0, 0.f);
+		if(!NodeCostsTimer.IsValid())
+		{
+			NodeCostsTimer = RegisterActiveTimer(HardReferenceInternals::NodeCostsAttachPeriod, FWidgetActiveTimerDelegate::CreateSP(this, &SHardReferenceFinderWindow::AttachNodeCosts));
+		}
+	}
+	else if(NodeCostsTimer.IsValid())
+	{
+		// Attached badges stay in place and hide themselves until shown again
+		UnRegisterActiveTimer(NodeCostsTimer.ToSharedRef());
+		NodeCostsTimer.Reset();
+	}
+}
+
+EVisibility SHardReferenceFinderWindow::GetVisibility_NodeCosts() const
+{
+	return !bAnalyzeEditorWorld && !AnalyzedAsset.IsValid() && BlueprintGraph.IsValid() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+EActiveTimerReturnType SHardReferenceFinderWindow::AttachNodeCosts(double InCurrentTime, float InDeltaTime)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	const TSharedPtr<FBlueprintEditor> PinnedBlueprintGraph = BlueprintGraph.Pin();
+	if(!PinnedBlueprintGraph.IsValid() || !NodeCosts->bVisible)
+	{
+		NodeCostsTimer.Reset();
+		return EActiveTimerReturnType::Stop;
+	}
+
+	// Only graphs in this blueprint's editor get badges, the costs don't apply to any other
+	const TSharedPtr<SDockTab> OwnerTab = PinnedBlueprintGraph->GetTabManager()->GetOwnerTab();
+	if(OwnerTab.IsValid())
+	{
+		SHardReferenceFinderNodeCosts::AttachToGraphPanels(OwnerTab->GetContent(), NodeCosts.ToSharedRef());
+	}
+	return EActiveTimerReturnType::Continue;
+}
+
+FText SHardReferenceFinderWindow::GetText_Trace() const
+{
+	if(LoadTrace.IsRecording())
+	{
+		return LOCTEXT("TraceRecording", "Tracing PIE...");
+	}
+	return LoadTrace.IsArmed() ? LOCTEXT("TraceArmed", "Cancel Trace") : LOCTEXT("Trace", "Trace PIE Loads");
+}
+
+EVisibility SHardReferenceFinderWindow::GetVisibility_Trace() const
+{
+	return GetTracedActorClass() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+const UClass* SHardReferenceFinderWindow::GetTracedActorClass() const
+{
+	const UBlueprint* Blueprint = bAnalyzeEditorWorld ? nullptr : GetSearchedBlueprint();
+	const UClass* GeneratedClass = Blueprint ? Blueprint->GeneratedClass.Get() : nullptr;
+	return GeneratedClass && GeneratedClass->IsChildOf(AActor::StaticClass()) ? GeneratedClass : nullptr;
+}
+
+void SHardReferenceFinderWindow::OnFilterTextChanged(const FText& Text)
+{
+	const TSet<FName> UserCollapsedPackages = GetCollapsedPackages();
+	FilterText = Text.ToString().TrimStartAndEnd();
+	ApplyFilter(UserCollapsedPackages);
+}
+
+void SHardReferenceFinderWindow::ApplyFilter(const TSet<FName>& UserCollapsedPackages)
+{
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+	TreeViewData = FilterText.IsEmpty() ? SearchResults : Filter.Apply(SearchResults, FilterText);
+	FilteredCollapsedPackages = UserCollapsedPackages;
+	TreeView->RebuildList();
+
+	// expand new items by default, unless they were intentionally collapsed.
+	for(const FHRFTreeViewItemPtr Item : TreeViewData)
+	{
+		const bool bWasCollapsed = UserCollapsedPackages.Contains(Item->PackageId);
+		const bool bShouldExpandItem = !bWasCollapsed;	
+		TreeView->SetItemExpansion(Item, bShouldExpandItem);
+	}
+}
+
+EVisibility SHardReferenceFinderWindow::GetVisibility_ClearDiff() const
+{
+	return DiffBaseline.IsValid() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+UWorld* SHardReferenceFinderWindow::GetEditorWorld() const
+{
+	return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+}
+
+void SHardReferenceFinderWindow::OnMapOpened(const FString& Filename, bool bAsTemplate)
+{
+	// The previous map's results, trace and baseline no longer apply
+	InitiateSearch();
+}
+
+UBlueprint* SHardReferenceFinderWindow::GetSearchedBlueprint() const
+{
+	if(bAnalyzeEditorWorld)
+	{
+		const UWorld* World = GetEditorWorld();
+		return World && World->PersistentLevel ? World->PersistentLevel->GetLevelScriptBlueprint(true) : nullptr;
+	}
+
+	if(AnalyzedAsset.IsValid())
+	{
+		return Cast<UBlueprint>(AnalyzedAsset.Get());
+	}
+
+	return BlueprintGraph.IsValid() ? BlueprintGraph.Pin()->GetBlueprintObj() : nullptr;
+}
+
+FName SHardReferenceFinderWindow::GetSearchedPackageName() const
+{
+	if(bAnalyzeEditorWorld)
+	{
+		const UWorld* World = GetEditorWorld();
+		return World ? World->GetPackage()->GetFName() : NAME_None;
+	}
+
+	if(AnalyzedAsset.IsValid())
+	{
+		return AnalyzedAsset->GetPackage()->GetFName();
+	}
+
+	if(BlueprintGraph.IsValid())
+	{
+		if(const UBlueprint* Blueprint = BlueprintGraph.Pin()->GetBlueprintObj())
+		{
+			return Blueprint->GetPackage()->GetFName();
+		}
+	}
+	return NAME_None;
+}
+
 bool SHardReferenceFinderWindow::BringAttentionToSCSNode(const FName& SCSIdentifier) const
 {
 	if(!SCSIdentifier.IsValid())
@@ -208,18 +1230,28 @@ bool SHardReferenceFinderWindow::BringAttentionToSCSNode(const FName& SCSIdentif
 
 void SHardReferenceFinderWindow::OnDoubleClickTreeEntry(TSharedPtr<FHRFTreeViewItem> Item) const
 {
-	if(Item.IsValid() && BlueprintGraph.IsValid())
+	if(!Item.IsValid())
+	{
+		return;
+	}
+
+	if(AActor* Actor = Cast<AActor>(Item->SourceObject.Get()))
+	{
+		GEditor->SelectNone(false, true);
+		GEditor->SelectActor(Actor, true, true);
+		GEditor->MoveViewportCamerasToActor(*Actor, false);
+		return;
+	}
+
+	if( UBlueprint* BlueprintObj = GetSearchedBlueprint() )
 	{
-		if( UBlueprint* BlueprintObj = BlueprintGraph.Pin()->GetBlueprintObj() )
+		if( const UEdGraphNode* GraphNode = FBlueprintEditorUtils::GetNodeByGUID(BlueprintObj, Item->NodeGuid) )
 		{
-			if( const UEdGraphNode* GraphNode = FBlueprintEditorUtils::GetNodeByGUID(BlueprintObj, Item->NodeGuid) )
-			{
-				FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(GraphNode);
-			}
-			else if(Item->SCSIdentifier.IsValid())
-			{
-				BringAttentionToSCSNode(Item->SCSIdentifier);
-			}
+			FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(GraphNode);
+		}
+		else if(Item->SCSIdentifier.IsValid())
+		{
+			BringAttentionToSCSNode(Item->SCSIdentifier);
 		}
 	}
 }
@@ -227,14 +1259,28 @@ void SHardReferenceFinderWindow::OnDoubleClickTreeEntry(TSharedPtr<FHRFTreeViewI
 void SHardReferenceFinderWindow::OnGetChildren(FHRFTreeViewItemPtr InItem, TArray<FHRFTreeViewItemPtr>& OutChildren) const
 {
 	OutChildren += InItem->Children;
+	OutChildren += InItem->Breakdown;
 }
 
 TSharedRef<ITableRow> SHardReferenceFinderWindow::OnGenerateRow(FHRFTreeViewItemPtr Item, const TSharedRef<STableViewBase>& TableViewBase) const
 {
+	LLM_SCOPE_BYTAG(HardReferenceFinder_UI);
+
+	// Rows are only generated for visible items, so this is where deferred titles and icons get looked up
+	Item->ResolveDisplayInfo();
+
 	if(Item->bIsHeader)
 	{
 		const FText SizeText = HardReferenceInternals::MakeBestSizeString(Item->SizeOnDisk);
-		const FText CategoryHeaderText = FText::Format(LOCTEXT("CategoryHeader", "{1} ({0})"), SizeText, Item->Name);
+		FText CategoryHeaderText = FText::Format(LOCTEXT("CategoryHeader", "{1} ({0})"), SizeText, Item->Name);
+		if(!Item->Chunks.IsEmpty())
+		{
+			CategoryHeaderText = FText::Format(LOCTEXT("CategoryHeaderChunks", "{0} chunks {1}"), CategoryHeaderText, FText::FromString(Item->Chunks));
+		}
+		if(Item->DiffState != EHRFDiffState::None && Item->SizeDelta != 0)
+		{
+			CategoryHeaderText = FText::Format(LOCTEXT("CategoryHeaderDiff", "{0} [{1}]"), CategoryHeaderText, HardReferenceInternals::MakeSizeDeltaString(Item->SizeDelta));
+		}
 
 		return SNew(STableRow<TSharedPtr<FName>>, TableViewBase)
 			.Style( GetStyle_HeaderRow() )
@@ -256,7 +1302,9 @@ TSharedRef<ITableRow> SHardReferenceFinderWindow::OnGenerateRow(FHRFTreeViewItem
 				.VAlign(VAlign_Center)
 				.Padding(2.f)
 				[
-					SNew(STextBlock).Text(CategoryHeaderText)
+					SNew(STextBlock)
+					.Text(CategoryHeaderText)
+					.ColorAndOpacity(HardReferenceInternals::GetDiffColor(Item->DiffState))
 				]
 			];
 	}
@@ -280,7 +1328,9 @@ TSharedRef<ITableRow> SHardReferenceFinderWindow::OnGenerateRow(FHRFTreeViewItem
 				.VAlign(VAlign_Center)
 				.Padding(2.f)
 				[
-					SNew(STextBlock).Text(Item->Name)
+					SNew(STextBlock)
+					.Text(Item->Name)
+					.ColorAndOpacity(HardReferenceInternals::GetDiffColor(Item->DiffState))
 				]
 			];
 	}
@@ -0,0 +1,82 @@
+#include "HardReferenceFinderDependencyGraph.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHardReferenceFinderDependencyGraphTest, "HardReferenceFinder.DependencyGraph", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHardReferenceFinderDependencyGraphTest::RunTest(const FString& Parameters)
+{
+	// A -> B <-> C -> F, B -> F, A -> D -> C, D -> D, E -> A
+	enum { A, B, C, D, E, F };
+	const FName PackageNames[] = { TEXT("/Test/A"), TEXT("/Test/B"), TEXT("/Test/C"), TEXT("/Test/D"), TEXT("/Test/E"), TEXT("/Test/F") };
+	const int64 DiskSizes[] = { 1, 10, 100, 1000, 10000, 100000 };
+	const TPair<int32, int32> Edges[] =
+	{
+		{ A, B }, { A, D },
+		{ B, C }, { B, F },
+		{ C, B }, { C, F },
+		{ D, C }, { D, D },
+		{ E, A },
+	};
+	const TSharedRef<FHardReferenceFinderDependencyGraph> Graph = FHardReferenceFinderDependencyGraph::BuildFromEdges(MakeArrayView(PackageNames), MakeArrayView(DiskSizes), MakeArrayView(Edges));
+
+	TestEqual(TEXT("Package count"), Graph->Num(), 6);
+	TestEqual(TEXT("Package lookup"), Graph->FindPackage(TEXT("/Test/D")), static_cast<int32>(D));
+	TestEqual(TEXT("Unknown package lookup"), Graph->FindPackage(TEXT("/Test/Missing")), static_cast<int32>(INDEX_NONE));
+
+	// The B <-> C cycle is condensed, the self-loop on D keeps it in a component of its own
+	TestEqual(TEXT("Component count"), Graph->NumComponents(), 5);
+	TestEqual(TEXT("Cycle shares a component"), Graph->GetComponent(B), Graph->GetComponent(C));
+	TestEqual(TEXT("Cycle component size"), Graph->GetComponentSize(Graph->GetComponent(B)), static_cast<int64>(110));
+	TestEqual(TEXT("Self-loop component members"), Graph->GetComponentPackages(Graph->GetComponent(D)).Num(), 1);
+
+	// Every package is counted once however many routes lead to it
+	TestEqual(TEXT("Closure of A"), Graph->GetClosureSize(A), static_cast<int64>(101111));
+	TestEqual(TEXT("Closure of B"), Graph->GetClosureSize(B), static_cast<int64>(100110));
+	TestEqual(TEXT("Closure through the self-loop"), Graph->GetClosureSize(D), static_cast<int64>(101110));
+	TestEqual(TEXT("Closure of E"), Graph->GetClosureSize(E), static_cast<int64>(111111));
+	TestEqual(TEXT("Closure of a leaf"), Graph->GetClosureSize(F), static_cast<int64>(100000));
+
+	TBitArray<> ClosureComponents(false, Graph->NumComponents());
+	Graph->GatherClosureComponents(B, ClosureComponents);
+	TestTrue(TEXT("Closure components of B include F"), ClosureComponents[Graph->GetComponent(F)]);
+	TestFalse(TEXT("Closure components of B exclude A"), ClosureComponents[Graph->GetComponent(A)]);
+	TestFalse(TEXT("Closure components of B exclude D"), ClosureComponents[Graph->GetComponent(D)]);
+
+	// Nothing references E, and a package only reaches itself through the self-loop
+	TestEqual(TEXT("Unreachable target"), Graph->FindShortestPaths(A, E, 4).Num(), 0);
+	const TArray<TArray<int32>> SelfPaths = Graph->FindShortestPaths(D, D, 4);
+	TestTrue(TEXT("Path to itself"), SelfPaths.Num() == 1 && SelfPaths[0] == TArray<int32>({ D }));
+
+	// A reaches F through four simple paths, which must come back shortest first without repeats
+	const TArray<TArray<int32>> Paths = Graph->FindShortestPaths(A, F, 10);
+	TestEqual(TEXT("Path count"), Paths.Num(), 4);
+	if(Paths.Num() == 4)
+	{
+		TestTrue(TEXT("Shortest path first"), Paths[0] == TArray<int32>({ A, B, F }));
+		TestTrue(TEXT("Longest path last"), Paths[3] == TArray<int32>({ A, D, C, B, F }));
+		for(int32 PathIndex = 0; PathIndex < Paths.Num(); ++PathIndex)
+		{
+			const TArray<int32>& Path = Paths[PathIndex];
+			TestTrue(TEXT("Paths start and end at the endpoints"), Path[0] == A && Path.Last() == F);
+			TestTrue(TEXT("Paths are ordered by length"), PathIndex == 0 || Paths[PathIndex - 1].Num() <= Path.Num());
+			TestEqual(TEXT("Paths are simple"), TSet<int32>(Path).Num(), Path.Num());
+			for(int32 Index = 0; Index + 1 < Path.Num(); ++Index)
+			{
+				TestTrue(TEXT("Paths follow edges"), Graph->GetDependencies(Path[Index]).Contains(Path[Index + 1]));
+			}
+			for(int32 OtherIndex = 0; OtherIndex < PathIndex; ++OtherIndex)
+			{
+				TestTrue(TEXT("Paths are unique"), Paths[OtherIndex] != Path);
+			}
+		}
+	}
+
+	const TArray<TArray<int32>> LimitedPaths = Graph->FindShortestPaths(A, F, 2);
+	TestTrue(TEXT("Path limit keeps the shortest paths"), LimitedPaths.Num() == 2 && LimitedPaths[0].Num() == 3 && LimitedPaths[1].Num() == 4);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include "HardReferenceFinderFilter.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HardReferenceFilterTestInternals
+{
+	FHRFTreeViewItemPtr MakeHeader(const TCHAR* PackageId, const TCHAR* AssetClass, const TCHAR* SourceName = nullptr)
+	{
+		const FHRFTreeViewItemPtr Header = MakeShared<FHRFTreeViewItem>();
+		Header->bIsHeader = true;
+		Header->PackageId = PackageId;
+		Header->AssetClass = AssetClass;
+		Header->Name = FText::FromString(FPaths::GetBaseFilename(PackageId));
+		if(SourceName)
+		{
+			const FHRFTreeViewItemPtr Source = MakeShared<FHRFTreeViewItem>();
+			Source->Name = FText::FromString(SourceName);
+			Header->Children.Add(Source);
+		}
+		return Header;
+	}
+
+	/* Names of the results the filter keeps, comma separated */
+	FString ApplyFilter(FHardReferenceFinderFilter& Filter, const TArray<FHRFTreeViewItemPtr>& Results, const FString& Query)
+	{
+		TArray<FString> Names;
+		for(const FHRFTreeViewItemPtr& Result : Filter.Apply(Results, Query))
+		{
+			Names.Add(Result->Name.ToString());
+		}
+		return FString::Join(Names, TEXT(","));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHardReferenceFinderFilterTest, "HardReferenceFinder.Filter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHardReferenceFinderFilterTest::RunTest(const FString& Parameters)
+{
+	using namespace HardReferenceFilterTestInternals;
+
+	// The closure total has no package and is kept by every query
+	const FHRFTreeViewItemPtr Total = MakeShared<FHRFTreeViewItem>();
+	Total->Name = FText::FromString(TEXT("Total"));
+
+	const TArray<FHRFTreeViewItemPtr> Results =
+	{
+		Total,
+		MakeHeader(TEXT("/Game/Characters/BP_Hero"), TEXT("Blueprint")),
+		MakeHeader(TEXT("/Game/Characters/BP_Heroes"), TEXT("Blueprint")),
+		MakeHeader(TEXT("/Game/Characters/BP_HeroCharacter"), TEXT("Blueprint")),
+		MakeHeader(TEXT("/Game/UI/T_HeroIcon"), TEXT("Texture2D"), TEXT("HeroPortrait")),
+	};
+
+	FHardReferenceFinderFilter Filter;
+	TestEqual(TEXT("Prefix of a word"), ApplyFilter(Filter, Results, TEXT("hero")), FString(TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter,T_HeroIcon")));
+	TestEqual(TEXT("Case change starts a token"), ApplyFilter(Filter, Results, TEXT("char")), FString(TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter")));
+	TestEqual(TEXT("Every word has to match"), ApplyFilter(Filter, Results, TEXT("hero ui")), FString(TEXT("Total,T_HeroIcon")));
+	TestEqual(TEXT("Source names"), ApplyFilter(Filter, Results, TEXT("Portrait")), FString(TEXT("Total,T_HeroIcon")));
+	TestEqual(TEXT("No match"), ApplyFilter(Filter, Results, TEXT("villain")), FString(TEXT("Total")));
+
+	// Quoted words match whole tokens, and every word inside the quotes has to
+	TestEqual(TEXT("Quoted word"), ApplyFilter(Filter, Results, TEXT("\"hero\"")), FString(TEXT("Total,BP_Hero")));
+	TestEqual(TEXT("Quoted path"), ApplyFilter(Filter, Results, TEXT("\"/Game/UI\"")), FString(TEXT("Total,T_HeroIcon")));
+	TestEqual(TEXT("Quoted words are not prefixes"), ApplyFilter(Filter, Results, TEXT("\"her\"")), FString(TEXT("Total")));
+
+	// Negated terms drop what they match, a negated quote only what matches all of its words
+	TestEqual(TEXT("Negated word"), ApplyFilter(Filter, Results, TEXT("hero -texture")), FString(TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter")));
+	TestEqual(TEXT("Negated quoted word"), ApplyFilter(Filter, Results, TEXT("-\"hero\"")), FString(TEXT("Total,BP_Heroes,BP_HeroCharacter,T_HeroIcon")));
+	TestEqual(TEXT("Negated quoted words"), ApplyFilter(Filter, Results, TEXT("-\"game characters hero\"")), FString(TEXT("Total,BP_Heroes,BP_HeroCharacter,T_HeroIcon")));
+	TestEqual(TEXT("Lone dash is ignored"), ApplyFilter(Filter, Results, TEXT("icon -")), FString(TEXT("Total,T_HeroIcon")));
+
+	// Narrowing as the query is typed, then widening again. Each step has to match filtering from scratch.
+	struct FStep
+	{
+		const TCHAR* Query;
+		const TCHAR* Expected;
+	};
+	const FStep Steps[] =
+	{
+		{ TEXT("h"), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter,T_HeroIcon") },
+		{ TEXT("her"), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter,T_HeroIcon") },
+		{ TEXT("heroc"), TEXT("Total,BP_HeroCharacter") },
+		{ TEXT("hero"), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter,T_HeroIcon") },
+		{ TEXT("hero bp"), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter") },
+		{ TEXT("hero bp -hero"), TEXT("Total") },
+		{ TEXT("hero bp -heroe"), TEXT("Total,BP_Hero,BP_HeroCharacter") },
+		{ TEXT("hero bp -heroes"), TEXT("Total,BP_Hero,BP_HeroCharacter") },
+		{ TEXT("hero bp"), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter") },
+		{ TEXT("\"hero"), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter,T_HeroIcon") },
+		{ TEXT("\"hero\""), TEXT("Total,BP_Hero") },
+		{ TEXT("\"hero\" c"), TEXT("Total,BP_Hero") },
+		{ TEXT("\"heroes\""), TEXT("Total,BP_Heroes") },
+		{ TEXT(""), TEXT("Total,BP_Hero,BP_Heroes,BP_HeroCharacter,T_HeroIcon") },
+	};
+	FHardReferenceFinderFilter IncrementalFilter;
+	for(const FStep& Step : Steps)
+	{
+		FHardReferenceFinderFilter FreshFilter;
+		const FString Expected = Step.Expected;
+		TestEqual(FString::Printf(TEXT("Incremental \"%s\""), Step.Query), ApplyFilter(IncrementalFilter, Results, Step.Query), Expected);
+		TestEqual(FString::Printf(TEXT("From scratch \"%s\""), Step.Query), ApplyFilter(FreshFilter, Results, Step.Query), Expected);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include "HardReferenceFinderResultsFile.h"
+#include "HardReferenceFinderSnapshot.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HardReferenceResultsFileTestInternals
+{
+	FHardReferenceFinderSnapshot MakeSnapshot(FName BlueprintPackage, int32 NumPackages, int64 ClosureSize)
+	{
+		TArray<FHRFSnapshotPackage> Packages;
+		for(int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+		{
+			FHRFSnapshotPackage& Package = Packages.AddDefaulted_GetRef();
+			Package.PackageId = *FString::Printf(TEXT("/Test/Header%d"), PackageIndex);
+			Package.SizeOnDisk = (int64(1) << 33) + PackageIndex;
+
+			// Every other package gets a component source, the names repeat so the string table is shared
+			for(int32 SourceIndex = 0; SourceIndex <= PackageIndex; ++SourceIndex)
+			{
+				FHRFSnapshotSource& Source = Package.Sources.AddDefaulted_GetRef();
+				Source.Name = FString::Printf(TEXT("Source%d"), SourceIndex);
+				Source.NodeGuid = FGuid(PackageIndex, SourceIndex, 1, 2);
+				if(SourceIndex % 2 == 1)
+				{
+					Source.SCSIdentifier = *FString::Printf(TEXT("Component%d"), SourceIndex);
+				}
+			}
+		}
+		return FHardReferenceFinderSnapshot(BlueprintPackage, MoveTemp(Packages), ClosureSize);
+	}
+
+	bool SnapshotsMatch(const FHardReferenceFinderSnapshot& Expected, const FHardReferenceFinderSnapshot& Actual)
+	{
+		if(Expected.GetBlueprintPackage() != Actual.GetBlueprintPackage() || Expected.GetClosureSize() != Actual.GetClosureSize() || Expected.GetPackages().Num() != Actual.GetPackages().Num())
+		{
+			return false;
+		}
+
+		for(int32 PackageIndex = 0; PackageIndex < Expected.GetPackages().Num(); ++PackageIndex)
+		{
+			const FHRFSnapshotPackage& ExpectedPackage = Expected.GetPackages()[PackageIndex];
+			const FHRFSnapshotPackage& ActualPackage = Actual.GetPackages()[PackageIndex];
+			if(ExpectedPackage.PackageId != ActualPackage.PackageId || ExpectedPackage.SizeOnDisk != ActualPackage.SizeOnDisk || ExpectedPackage.Sources.Num() != ActualPackage.Sources.Num())
+			{
+				return false;
+			}
+
+			for(int32 SourceIndex = 0; SourceIndex < ExpectedPackage.Sources.Num(); ++SourceIndex)
+			{
+				const FHRFSnapshotSource& ExpectedSource = ExpectedPackage.Sources[SourceIndex];
+				const FHRFSnapshotSource& ActualSource = ActualPackage.Sources[SourceIndex];
+				if(ExpectedSource.Name != ActualSource.Name || ExpectedSource.NodeGuid != ActualSource.NodeGuid || ExpectedSource.SCSIdentifier != ActualSource.SCSIdentifier)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHardReferenceFinderResultsFileRoundTripTest, "HardReferenceFinder.ResultsFile.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHardReferenceFinderResultsFileRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace HardReferenceResultsFileTestInternals;
+
+	const FString FileName = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("HardReferenceFinder"), TEXT("RoundTrip.hrfsnap"));
+
+	// Added out of order, the writer sorts blueprints by name for the lookup
+	const FHardReferenceFinderSnapshot Snapshots[] =
+	{
+		MakeSnapshot(TEXT("/Test/BP_Zebra"), 3, 123456789012),
+		MakeSnapshot(TEXT("/Test/BP_Apple"), 2, 0),
+		MakeSnapshot(TEXT("/Test/BP_Empty"), 0, 42),
+	};
+
+	FHardReferenceFinderResultsWriter Writer;
+	for(const FHardReferenceFinderSnapshot& Snapshot : Snapshots)
+	{
+		Writer.AddBlueprint(Snapshot);
+	}
+	TestEqual(TEXT("Writer blueprint count"), Writer.GetNumBlueprints(), 3);
+	if(!TestTrue(TEXT("Results file saved"), Writer.SaveToFile(FileName)))
+	{
+		return false;
+	}
+
+	{
+		const TUniquePtr<FHardReferenceFinderResultsFile> ResultsFile = FHardReferenceFinderResultsFile::Open(FileName);
+		if(!TestTrue(TEXT("Results file opened"), ResultsFile.IsValid()))
+		{
+			IFileManager::Get().Delete(*FileName);
+			return false;
+		}
+
+		TestEqual(TEXT("Blueprint count"), ResultsFile->GetNumBlueprints(), 3);
+		TestEqual(TEXT("Blueprints are sorted"), ResultsFile->GetBlueprintName(0).ToString(), FString(TEXT("/Test/BP_Apple")));
+		TestEqual(TEXT("Unknown blueprint lookup"), ResultsFile->FindBlueprint(TEXT("/Test/BP_Missing")), static_cast<int32>(INDEX_NONE));
+
+		for(const FHardReferenceFinderSnapshot& Expected : Snapshots)
+		{
+			const int32 BlueprintIndex = ResultsFile->FindBlueprint(Expected.GetBlueprintPackage());
+			TestTrue(FString::Printf(TEXT("%s found"), *Expected.GetBlueprintPackage().ToString()), BlueprintIndex != INDEX_NONE);
+			TestEqual(FString::Printf(TEXT("%s closure size"), *Expected.GetBlueprintPackage().ToString()), ResultsFile->GetBlueprintClosureSize(BlueprintIndex), Expected.GetClosureSize());
+
+			FHardReferenceFinderSnapshot Actual;
+			TestTrue(FString::Printf(TEXT("%s read"), *Expected.GetBlueprintPackage().ToString()), ResultsFile->ReadBlueprint(BlueprintIndex, Actual));
+			TestTrue(FString::Printf(TEXT("%s matches"), *Expected.GetBlueprintPackage().ToString()), SnapshotsMatch(Expected, Actual));
+		}
+	}
+
+	// A single blueprint file round trips through the snapshot interface as well
+	TestTrue(TEXT("Snapshot saved"), Snapshots[0].SaveToFile(FileName));
+	FHardReferenceFinderSnapshot Loaded;
+	TestTrue(TEXT("Snapshot loaded"), Loaded.LoadFromFile(FileName, NAME_None));
+	TestTrue(TEXT("Snapshot matches"), SnapshotsMatch(Snapshots[0], Loaded));
+
+	IFileManager::Get().Delete(*FileName);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHardReferenceFinderResultsFileCorruptTest, "HardReferenceFinder.ResultsFile.Corrupt", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHardReferenceFinderResultsFileCorruptTest::RunTest(const FString& Parameters)
+{
+	using namespace HardReferenceResultsFileTestInternals;
+
+	const FString FileName = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("HardReferenceFinder"), TEXT("Corrupt.hrfsnap"));
+
+	FHardReferenceFinderResultsWriter Writer;
+	Writer.AddBlueprint(MakeSnapshot(TEXT("/Test/BP_Corrupt"), 3, 1000));
+	TArray<uint8> ValidBytes;
+	if(!TestTrue(TEXT("Results file saved"), Writer.SaveToFile(FileName)) || !TestTrue(TEXT("Results file read back"), FFileHelper::LoadFileToArray(ValidBytes, *FileName)))
+	{
+		return false;
+	}
+
+	auto OpensAs = [&FileName](const TArray<uint8>& Bytes)
+	{
+		FFileHelper::SaveArrayToFile(Bytes, *FileName);
+		return FHardReferenceFinderResultsFile::Open(FileName).IsValid();
+	};
+
+	TestTrue(TEXT("Valid file opens"), OpensAs(ValidBytes));
+
+	TestFalse(TEXT("Empty file is rejected"), OpensAs(TArray<uint8>()));
+
+	TArray<uint8> PartialHeader(ValidBytes.GetData(), sizeof(HardReferenceResultsFormat::FHeader) / 2);
+	TestFalse(TEXT("Partial header is rejected"), OpensAs(PartialHeader));
+
+	TArray<uint8> BadMagic = ValidBytes;
+	BadMagic[0] ^= 0xFF;
+	TestFalse(TEXT("Bad magic is rejected"), OpensAs(BadMagic));
+
+	// Every section is validated against the file size, so losing any of the tail invalidates the file
+	for(const int32 DroppedBytes : { 1, static_cast<int32>(sizeof(HardReferenceResultsFormat::FSourceRecord)), ValidBytes.Num() - static_cast<int32>(sizeof(HardReferenceResultsFormat::FHeader)) })
+	{
+		TArray<uint8> Truncated(ValidBytes.GetData(), ValidBytes.Num() - DroppedBytes);
+		TestFalse(FString::Printf(TEXT("File missing %d bytes is rejected"), DroppedBytes), OpensAs(Truncated));
+	}
+
+	IFileManager::Get().Delete(*FileName);
+	return true;
+}
+
+#endif
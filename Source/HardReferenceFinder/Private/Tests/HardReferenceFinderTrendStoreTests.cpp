@@ -0,0 +1,155 @@
+#include "HardReferenceFinderTrendStore.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HardReferenceTrendStoreTestInternals
+{
+	using FTopHeader = TPair<FName, int64>;
+
+	FHRFTrendSample MakeSample(int64 Timestamp, int32 Changelist, int64 TotalSize, int32 NumPackages, TArray<FTopHeader> TopHeaders)
+	{
+		FHRFTrendSample Sample;
+		Sample.Timestamp = Timestamp;
+		Sample.Changelist = Changelist;
+		Sample.TotalSize = TotalSize;
+		Sample.NumPackages = NumPackages;
+		Sample.TopHeaders = MoveTemp(TopHeaders);
+		return Sample;
+	}
+
+	bool HistoriesMatch(const TArray<FHRFTrendSample>& Expected, const TArray<FHRFTrendSample>& Actual)
+	{
+		if(Expected.Num() != Actual.Num())
+		{
+			return false;
+		}
+
+		for(int32 SampleIndex = 0; SampleIndex < Expected.Num(); ++SampleIndex)
+		{
+			const FHRFTrendSample& Lhs = Expected[SampleIndex];
+			const FHRFTrendSample& Rhs = Actual[SampleIndex];
+			if(Lhs.Timestamp != Rhs.Timestamp || Lhs.Changelist != Rhs.Changelist || Lhs.TotalSize != Rhs.TotalSize || Lhs.NumPackages != Rhs.NumPackages || Lhs.TopHeaders != Rhs.TopHeaders)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHardReferenceFinderTrendStoreRoundTripTest, "HardReferenceFinder.TrendStore.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHardReferenceFinderTrendStoreRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace HardReferenceTrendStoreTestInternals;
+
+	const FString StorePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("HardReferenceFinder"), TEXT("RoundTrip.hrftrend"));
+	IFileManager::Get().Delete(*StorePath, false, true, true);
+
+	const FName Hero(TEXT("/Test/BP_Hero"));
+	const FName Enemy(TEXT("/Test/BP_Enemy"));
+	const FName SharedHeader(TEXT("/Test/Shared"));
+	const FName WideHeader(TEXT("/Test/\u00DCn\u00EFc\u00F6d\u00E9_Header"));
+
+	// Sizes and changelists shrink as well as grow so that both signs of every delta are encoded, the large values
+	// need all ten bytes of a varint
+	const TArray<FHRFTrendSample> HeroSamples =
+	{
+		MakeSample(1700000000, 100, 5000, 10, { FTopHeader(SharedHeader, 3000), FTopHeader(WideHeader, 1000) }),
+		MakeSample(1700000600, 90, 4000, 8, { FTopHeader(SharedHeader, 2500) }),
+		MakeSample(1700086400, 120, MAX_int64 / 2, MAX_int32, { FTopHeader(WideHeader, MAX_int64) }),
+		MakeSample(1600000000, 0, 0, 0, {}),
+	};
+	const TArray<FHRFTrendSample> EnemySamples =
+	{
+		MakeSample(1700000300, 95, 7000, 12, { FTopHeader(SharedHeader, 3000) }),
+		MakeSample(1700000900, 95, 6500, 12, { FTopHeader(SharedHeader, 2800), FTopHeader(WideHeader, 10) }),
+	};
+
+	{
+		// Two stores on one file stand in for two processes, each append has to pick up the strings the other defined
+		FHardReferenceFinderTrendStore First(StorePath);
+		FHardReferenceFinderTrendStore Second(StorePath);
+		First.Record(Hero, HeroSamples[0]);
+		Second.Record(Enemy, EnemySamples[0]);
+		First.Record(Hero, HeroSamples[1]);
+		Second.Record(Hero, HeroSamples[2]);
+		First.Record(Enemy, EnemySamples[1]);
+		First.Record(Hero, HeroSamples[3]);
+
+		// Unchanged apart from the time, so not recorded
+		const int64 SizeBeforeDuplicate = IFileManager::Get().FileSize(*StorePath);
+		Second.Record(Hero, MakeSample(1800000000, 0, 0, 0, {}));
+		TestEqual(TEXT("Unchanged sample is skipped"), IFileManager::Get().FileSize(*StorePath), SizeBeforeDuplicate);
+
+		TestTrue(TEXT("Writer sees its own and the other writer's samples"), HistoriesMatch(HeroSamples, First.GetHistory(Hero)));
+		TestTrue(TEXT("Other writer sees every sample"), HistoriesMatch(EnemySamples, Second.GetHistory(Enemy)));
+	}
+
+	FHardReferenceFinderTrendStore Reader(StorePath);
+	TestTrue(TEXT("Hero history round trips"), HistoriesMatch(HeroSamples, Reader.GetHistory(Hero)));
+	TestTrue(TEXT("Enemy history round trips"), HistoriesMatch(EnemySamples, Reader.GetHistory(Enemy)));
+	TestEqual(TEXT("Unknown blueprint has no history"), Reader.GetHistory(TEXT("/Test/BP_Missing")).Num(), 0);
+
+	IFileManager::Get().Delete(*StorePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHardReferenceFinderTrendStorePartialRecordTest, "HardReferenceFinder.TrendStore.PartialRecord", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHardReferenceFinderTrendStorePartialRecordTest::RunTest(const FString& Parameters)
+{
+	using namespace HardReferenceTrendStoreTestInternals;
+
+	const FString StorePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("HardReferenceFinder"), TEXT("PartialRecord.hrftrend"));
+	IFileManager::Get().Delete(*StorePath, false, true, true);
+
+	const FName Hero(TEXT("/Test/BP_Hero"));
+	const TArray<FHRFTrendSample> Samples =
+	{
+		MakeSample(1700000000, 100, 5000, 10, { FTopHeader(TEXT("/Test/Shared"), 3000) }),
+		MakeSample(1700000600, 101, 6000, 11, { FTopHeader(TEXT("/Test/Shared"), 3500) }),
+	};
+
+	TArray<uint8> CompleteBytes;
+	{
+		FHardReferenceFinderTrendStore Writer(StorePath);
+		Writer.Record(Hero, Samples[0]);
+		TestTrue(TEXT("First sample written"), FFileHelper::LoadFileToArray(CompleteBytes, *StorePath));
+		Writer.Record(Hero, Samples[1]);
+	}
+
+	// Leave the second sample cut off part way, as a writer that crashed mid-append would
+	TArray<uint8> PartialBytes;
+	if(!TestTrue(TEXT("Store written"), FFileHelper::LoadFileToArray(PartialBytes, *StorePath)) || !TestTrue(TEXT("Second sample appended"), PartialBytes.Num() > CompleteBytes.Num() + 2))
+	{
+		return false;
+	}
+	PartialBytes.SetNum(PartialBytes.Num() - 2);
+	FFileHelper::SaveArrayToFile(PartialBytes, *StorePath);
+
+	AddExpectedError(TEXT("Stopped reading"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("can't be read past"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FHardReferenceFinderTrendStore Reader(StorePath);
+	const TArray<FHRFTrendSample> ExpectedHistory = { Samples[0] };
+	TestTrue(TEXT("Complete records are read"), HistoriesMatch(ExpectedHistory, Reader.GetHistory(Hero)));
+
+	// Appending after the partial record would make everything after it unreadable
+	Reader.Record(Hero, MakeSample(1700001200, 102, 7000, 12, {}));
+	TestEqual(TEXT("Partial record is not appended to"), IFileManager::Get().FileSize(*StorePath), static_cast<int64>(PartialBytes.Num()));
+	TestTrue(TEXT("Refused sample is not kept"), HistoriesMatch(ExpectedHistory, Reader.GetHistory(Hero)));
+
+	TArray<uint8> BytesAfter;
+	FFileHelper::LoadFileToArray(BytesAfter, *StorePath);
+	TestTrue(TEXT("File is not rewritten"), BytesAfter == PartialBytes);
+
+	IFileManager::Get().Delete(*StorePath);
+	return true;
+}
+
+#endif
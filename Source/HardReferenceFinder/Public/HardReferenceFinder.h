@@ -7,6 +7,11 @@
 
 class FWorkflowAllowedTabSet;
 class FBlueprintEditor;
+class FExtender;
+class FSpawnTabArgs;
+class FUICommandList;
+class SDockTab;
+struct FAssetData;
 
 class FHardReferenceFinderModule : public IModuleInterface
 {
@@ -17,4 +22,14 @@ public:
 	
 private:
 	void RegisterBlueprintTabs(FWorkflowAllowedTabSet& TabManager, FName ModeName, TSharedPtr<FBlueprintEditor> InBlueprintEditor) const;
+	TSharedRef<SDockTab> SpawnLevelTab(const FSpawnTabArgs& SpawnTabArgs) const;
+	TSharedRef<SDockTab> SpawnHeatmapTab(const FSpawnTabArgs& SpawnTabArgs) const;
+	TSharedRef<SDockTab> SpawnAggregateTab(const FSpawnTabArgs& SpawnTabArgs) const;
+	TSharedRef<FExtender> ExtendContentBrowserMenu(const TArray<FAssetData>& SelectedAssets) const;
+	static void OpenAggregateTab(TArray<FAssetData> SelectedAssets);
+	TSharedRef<FExtender> ExtendAssetEditorMenu(const TSharedRef<FUICommandList> CommandList, const TArray<UObject*> EditingObjects) const;
+	static void OpenAssetEditorTab(TWeakObjectPtr<UObject> Asset);
+
+	FDelegateHandle AssetEditorExtenderHandle;
+	FDelegateHandle ContentBrowserExtenderHandle;
 };
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HardReferenceFinderCookedRegistry.h"
+#include "Async/Future.h"
+#include "Textures/SlateIcon.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FHardReferenceFinderCookedRegistry;
+class FHardReferenceFinderDependencyGraph;
+class UBlueprint;
+
+/* A package referenced by the value of a property in a class default object */
+struct FHRFPropertyReference
+{
+	FName PackageName = NAME_None;
+	FName PropertyName = NAME_None;
+	FSlateIcon Icon;
+
+	/* The class that declared the property, differs from the analyzed class when an inherited default was overridden */
+	TWeakObjectPtr<const UClass> DeclaringClass;
+	bool bIsOverride = false;
+
+	/* The property holds a soft object or soft class path to the package */
+	bool bIsSoft = false;
+};
+
+/* Results of scanning the default object of a single class in a blueprint hierarchy */
+struct FHRFClassAnalysis
+{
+	TArray<FHRFPropertyReference> PropertyReferences;
+
+	/* Inherited properties whose default differs from the parent class */
+	TSet<FName> OverriddenProperties;
+};
+
+/* Size of everything a package hard references, split by asset class and by top level content folder */
+struct FHRFClosureSize
+{
+	int64 TotalSize = 0;
+	int32 NumPackages = 0;
+	TMap<FName, int64> SizeByClass;
+	TMap<FName, int64> SizeByFolder;
+
+	/* Every chunk the closure touches, only filled in for cooked sizes */
+	FHRFChunkSet Chunks;
+
+	/* Bytes of packages in the closure that share no chunk with the package the closure starts from */
+	int64 ForeignChunkSize = 0;
+};
+
+/*
+ * Results shared between every search in the editor. Analysis is stored per class so that a hierarchy of blueprints
+ * only scans each class once, and closure sizes are stored per package so shared subtrees are only walked once.
+ */
+class FHardReferenceFinderCache
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+	static FHardReferenceFinderCache& Get();
+
+	TSharedRef<const FHRFClassAnalysis> FindOrAddClassAnalysis(const UClass* Class, TFunctionRef<void(FHRFClassAnalysis&)> Analyze);
+
+	/* SizePlatform is the cooked platform the sizes were read from, none for editor sizes */
+	TSharedRef<const FHRFClosureSize> FindOrAddClosureSize(FName PackageName, FName SizePlatform, TFunctionRef<void(FHRFClosureSize&)> GatherSize);
+
+	/* Registry-only copy of the project's hard dependencies, built on first use and kept until the registry changes */
+	TSharedRef<const FHardReferenceFinderDependencyGraph> GetDependencyGraph();
+
+	/*
+	 * Calls OnBuilt on the game thread with the dependency graph, right away when it's already built. Otherwise the
+	 * graph is built on a worker thread, only copying it out of the registry stays on the game thread before UE 5.0.
+	 */
+	void GetDependencyGraphAsync(TFunction<void(TSharedRef<const FHardReferenceFinderDependencyGraph>)> OnBuilt);
+
+	/* Cooked sizes for a platform, loaded on first use and reloaded when the platform is cooked again */
+	TSharedPtr<const FHardReferenceFinderCookedRegistry> FindOrLoadCookedRegistry(FName PlatformName);
+
+	void InvalidateClassAnalysis();
+	void InvalidateClosureSizes();
+	void InvalidateDependencyGraph();
+	void InvalidateCookedRegistries();
+
+private:
+	void BindInvalidationEvents();
+	void UnbindInvalidationEvents();
+	void FinishDependencyGraphBuild();
+	void SetDependencyGraph(const TSharedRef<const FHardReferenceFinderDependencyGraph>& Graph);
+	void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+	void OnAssetRegistryChanged(const struct FAssetData& AssetData);
+	void OnAssetRegistryRenamed(const struct FAssetData& AssetData, const FString& OldObjectPath);
+
+	TMap<TWeakObjectPtr<const UClass>, TSharedRef<const FHRFClassAnalysis>> ClassAnalyses;
+	TMap<TPair<FName, FName>, TSharedRef<const FHRFClosureSize>> ClosureSizes;
+	TSharedPtr<const FHardReferenceFinderDependencyGraph> DependencyGraph;
+
+	/*
+	 * A graph being built on a worker, kept only if nothing invalidated the graph since the build started. The worker
+	 * only gets a raw pointer, so the graph's reference count is never touched from two threads.
+	 */
+	TSharedPtr<FHardReferenceFinderDependencyGraph> PendingDependencyGraph;
+	TFuture<void> PendingDependencyGraphBuild;
+	TArray<TFunction<void(TSharedRef<const FHardReferenceFinderDependencyGraph>)>> PendingDependencyGraphCallbacks;
+	uint32 DependencyGraphGeneration = 0;
+	uint32 PendingDependencyGraphGeneration = 0;
+	TMap<FName, TSharedRef<const FHardReferenceFinderCookedRegistry>> CookedRegistries;
+
+	static TUniquePtr<FHardReferenceFinderCache> Instance;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HardReferenceFinderSearchData.h"
+#include "HardReferenceFinderSnapshot.h"
+#include "Misc/EngineVersionComparison.h"
+
+class FHardReferenceFinderCookedRegistry;
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+class FObjectPostSaveContext;
+#endif
+
+/*
+ * Writes the hard references of every cooked blueprint as a by-product of a cook, so no separate audit has to load
+ * the project again. Off by default, enable it with HardReferenceFinder.CookReport.Enable 1, e.g. by passing
+ * -ini:Engine:[ConsoleVariables]:HardReferenceFinder.CookReport.Enable=1 to the cook commandlet.
+ *
+ * Blueprints are scanned right after the cooker saves their package, while the cooker still has them loaded. Once
+ * the cook has finished and its asset registry is on disk, the closure of every header is sized from that platform's
+ * cooked registry and the results are written to Saved/HardReferenceFinder/CookReports/<Platform>.hrfaudit, which
+ * can be opened with Compare... in any hard references window. The time spent in the hook is logged along with its
+ * share of the cook.
+ */
+class FHardReferenceFinderCookReport
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	static bool IsEnabled();
+	static FString GetReportPath(FName PlatformName);
+
+	FHardReferenceFinderCookReport();
+	~FHardReferenceFinderCookReport();
+
+private:
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	void OnPackageSaved(const FString& PackageFileName, UObject* PackageObject);
+#else
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+#endif
+	void ScanPackage(UPackage* Package);
+	void WriteReports();
+
+	/* Closure sizes from a platform's cooked registry for every scanned blueprint and every package it references */
+	TMap<FName, int64> GatherCookedClosureSizes(const FHardReferenceFinderCookedRegistry& CookedRegistry) const;
+
+	/* Sources of each scanned blueprint, headers are only sized per platform once the cook is done */
+	TArray<FHardReferenceFinderSnapshot> Snapshots;
+
+	/* Packages are saved once per cooked platform but only scanned the first time */
+	TSet<FName> ScannedPackages;
+
+	/* Reused by every scan so its scratch storage is only grown once. Sources only, editor sizes would be discarded. */
+	FHardReferenceFinderSearchData SearchData;
+
+	double ScanSeconds = 0.0;
+	double ReportSeconds = 0.0;
+
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle EnginePreExitHandle;
+
+	static TUniquePtr<FHardReferenceFinderCookReport> Instance;
+};
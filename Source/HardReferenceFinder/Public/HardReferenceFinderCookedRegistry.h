@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* A set of chunks stored as a bitset over the chunk indices of one cooked registry, so closures can merge them cheaply */
+struct FHRFChunkSet
+{
+	void Add(int32 ChunkIndex)
+	{
+		const int32 WordIndex = ChunkIndex / 64;
+		if(WordIndex >= Words.Num())
+		{
+			Words.SetNumZeroed(WordIndex + 1);
+		}
+		Words[WordIndex] |= uint64(1) << (ChunkIndex % 64);
+	}
+
+	void Append(const FHRFChunkSet& Other)
+	{
+		if(Other.Words.Num() > Words.Num())
+		{
+			Words.SetNumZeroed(Other.Words.Num());
+		}
+		for(int32 WordIndex = 0; WordIndex < Other.Words.Num(); ++WordIndex)
+		{
+			Words[WordIndex] |= Other.Words[WordIndex];
+		}
+	}
+
+	bool Intersects(const FHRFChunkSet& Other) const
+	{
+		const int32 NumWords = FMath::Min(Words.Num(), Other.Words.Num());
+		for(int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			if(Words[WordIndex] & Other.Words[WordIndex])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsEmpty() const
+	{
+		for(const uint64 Word : Words)
+		{
+			if(Word != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	SIZE_T GetAllocatedSize() const { return Words.GetAllocatedSize(); }
+
+	template<typename FunctionType>
+	void ForEach(FunctionType Function) const
+	{
+		for(int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			for(uint64 Word = Words[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				Function(WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Word)));
+			}
+		}
+	}
+
+private:
+	TArray<uint64, TInlineAllocator<1>> Words;
+};
+
+/*
+ * Package sizes and chunk assignments read from the asset registry written by the cooker for one target platform.
+ * Cooked sizes reflect what actually ships, e.g. textures after compression and stripped editor-only data, unlike the
+ * editor registry which reports the size of the uncooked .uasset files.
+ */
+class FHardReferenceFinderCookedRegistry
+{
+public:
+	/* Platforms with a cooked registry in the project's Saved/Cooked folder */
+	static TArray<FName> FindCookedPlatforms();
+
+	/* Prefers the development registry, which is written for every cook, over the shipped AssetRegistry.bin */
+	static FString FindRegistryFile(FName PlatformName);
+
+	/* Returns null when the platform has no cooked registry or it can't be read */
+	static TSharedPtr<FHardReferenceFinderCookedRegistry> Load(FName PlatformName);
+
+	FName GetPlatformName() const { return PlatformName; }
+	FDateTime GetTimeStamp() const { return TimeStamp; }
+
+	/* Cooked size of a package, zero for packages that were not part of the cook */
+	int64 GetCookedSize(FName PackageName) const;
+
+	/* Chunks the cooker assigned a package to, null for packages that were not part of the cook */
+	const FHRFChunkSet* FindChunks(FName PackageName) const;
+
+	FString MakeChunkListString(const FHRFChunkSet& Chunks) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FCookedPackage
+	{
+		int64 CookedSize = 0;
+		FHRFChunkSet Chunks;
+	};
+
+	FName PlatformName = NAME_None;
+
+	/* Modification time of the registry file when it was loaded, used to notice a newer cook */
+	FDateTime TimeStamp;
+
+	TMap<FName, FCookedPackage> CookedPackages;
+
+	/* Chunk sets store dense indices, this maps them back to the chunk ids used in the pak file names */
+	TArray<int32> ChunkIds;
+};
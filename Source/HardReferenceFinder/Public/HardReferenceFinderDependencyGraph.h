@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetRegistryModule;
+
+/*
+ * Flat copy of the hard package dependencies known to the asset registry. Packages are addressed by index and their
+ * edges are stored in one contiguous array, so the graph can be walked from many threads without touching the
+ * registry. Strongly connected packages are condensed into single components to speed up closure walks.
+ */
+class FHardReferenceFinderDependencyGraph
+{
+public:
+	/* Must be called on the game thread before UE 5.0, the registry is only read while building */
+	static TSharedRef<FHardReferenceFinderDependencyGraph> Build(FAssetRegistryModule& AssetRegistryModule);
+
+	/*
+	 * The two halves of Build, called in order on an empty graph. CopyFromRegistry only copies packages, edges and sizes
+	 * out of the registry, BuildIndices adds the reversed edges and components without touching the registry, so it can
+	 * run on any thread. The graph can't be used in between.
+	 */
+	void CopyFromRegistry(FAssetRegistryModule& AssetRegistryModule);
+	void BuildIndices();
+
+	/* Builds a graph from explicit packages and (referencer, dependency) index pairs, used by the automation tests */
+	static TSharedRef<FHardReferenceFinderDependencyGraph> BuildFromEdges(TArrayView<const FName> InPackageNames, TArrayView<const int64> InDiskSizes, TArrayView<const TPair<int32, int32>> Edges);
+
+	int32 Num() const { return PackageNames.Num(); }
+	int32 FindPackage(FName PackageName) const;
+	FName GetPackageName(int32 Package) const { return PackageNames[Package]; }
+	int64 GetDiskSize(int32 Package) const { return DiskSizes[Package]; }
+	TArrayView<const int32> GetDependencies(int32 Package) const;
+	TArrayView<const int32> GetReferencers(int32 Package) const;
+
+	/* Size of the package and everything it hard references, matches FHardReferenceFinderSearchData's header sizes */
+	int64 GetClosureSize(int32 Package) const;
+
+	/* Strongly connected packages share a component, closures are the same for every package in one */
+	int32 NumComponents() const { return ComponentSizes.Num(); }
+	int32 GetComponent(int32 Package) const { return ComponentOf[Package]; }
+	int64 GetComponentSize(int32 Component) const { return ComponentSizes[Component]; }
+	TArrayView<const int32> GetComponentPackages(int32 Component) const;
+
+	/* Sets the bit of every component in the closure of a package, OutComponents must hold NumComponents() bits */
+	void GatherClosureComponents(int32 Package, TBitArray<>& OutComponents) const;
+
+	/* Up to MaxPaths of the shortest hard reference chains from one package to another, shortest first */
+	TArray<TArray<int32>> FindShortestPaths(int32 FromPackage, int32 ToPackage, int32 MaxPaths) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 FindOrAddPackage(FName PackageName);
+	void BuildReferencers();
+	void BuildComponents();
+	bool FindShortestPath(TArray<int32>& OutPath, int32 FromPackage, int32 ToPackage, const TSet<int32>& BlockedPackages, const TSet<TPair<int32, int32>>& BlockedEdges) const;
+
+	TArray<FName> PackageNames;
+	TMap<FName, int32> PackageToIndex;
+	TArray<int64> DiskSizes;
+
+	/* Dependencies of package N are Dependencies[DependencyOffsets[N] .. DependencyOffsets[N+1]] */
+	TArray<int32> DependencyOffsets;
+	TArray<int32> Dependencies;
+
+	/* The same edges reversed, used to search backwards from a package */
+	TArray<int32> ReferencerOffsets;
+	TArray<int32> Referencers;
+
+	/* Strongly connected components, laid out the same way as the package edges */
+	TArray<int32> ComponentOf;
+	TArray<int64> ComponentSizes;
+	TArray<int32> ComponentDependencyOffsets;
+	TArray<int32> ComponentDependencies;
+	TArray<int32> ComponentPackageOffsets;
+	TArray<int32> ComponentPackages;
+};
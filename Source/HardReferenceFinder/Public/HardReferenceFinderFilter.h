@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HardReferenceFinderSearchData.h"
+
+/*
+ * Token index over the results of a search, used to filter the results window as the user types. A header matches
+ * when every word of the query starts one of the tokens of its package path, asset class, name or the names of the
+ * sources that reference it. Tokens are split at separators and at case changes, so "char" finds "BP_HeroCharacter".
+ * A quoted word has to match a whole token instead of starting one, and a term starting with '-' excludes the headers
+ * it matches, so -"hero" drops "BP_Hero" but keeps "BP_Heroes".
+ */
+class FHardReferenceFinderFilter
+{
+public:
+	/* Drops the index, it is rebuilt on the next Apply */
+	void Reset();
+
+	/* Results that match Query, in their original order. Results without a package, e.g. the closure total, always match. */
+	TArray<FHRFTreeViewItemPtr> Apply(const TArray<FHRFTreeViewItemPtr>& Results, const FString& Query);
+
+private:
+	/* A whitespace separated part of the query, or a quoted one. It matches a result when each of its words does. */
+	struct FTerm
+	{
+		TArray<FString> Words;
+		bool bIsQuoted = false;
+		bool bIsNegated = false;
+
+		bool operator==(const FTerm& Other) const
+		{
+			return Words == Other.Words && bIsQuoted == Other.bIsQuoted && bIsNegated == Other.bIsNegated;
+		}
+	};
+
+	void Build(const TArray<FHRFTreeViewItemPtr>& Results);
+	void MarkMatchingResults(const FString& Word, bool bIsExact, TBitArray<>& OutResults) const;
+	static void SplitWords(const FString& Text, TArray<FString>& OutWords);
+	static void ParseQuery(const FString& Query, TArray<FTerm>& OutTerms);
+
+	/* Whether everything matching Terms also matched PreviousTerms */
+	static bool IsNarrowing(const TArray<FTerm>& PreviousTerms, const TArray<FTerm>& Terms);
+
+	bool bIsBuilt = false;
+
+	/* Sorted unique tokens, and for each the sorted indices of the results containing it */
+	TArray<FString> Tokens;
+	TArray<TArray<int32>> TokenResults;
+	int32 NumResults = 0;
+
+	/* Matches of the previous query, only these can match a query that narrows it down */
+	TArray<FTerm> LastTerms;
+	TArray<int32> LastMatches;
+	bool bHasLastMatches = false;
+};
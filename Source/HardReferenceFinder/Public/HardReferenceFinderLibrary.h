@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "HardReferenceFinderLibrary.generated.h"
+
+/* Everything a package hard references, read from the asset registry */
+USTRUCT(BlueprintType)
+struct FHRFClosureInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	FName PackageName;
+
+	/* False when the package isn't in the asset registry, every other field is left empty */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	bool bFound = false;
+
+	/* Disk size of the package and everything it hard references, matches the size of the window's headers */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	int64 TotalSize = 0;
+
+	/* Packages in the closure, including the package itself */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	int32 NumPackages = 0;
+
+	/* Packages referenced directly */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	TArray<FName> Dependencies;
+
+	/* Every package in the closure, only filled in when requested */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	TArray<FName> Packages;
+};
+
+/* One chain of hard references, from the package searched from to the package searched for */
+USTRUCT(BlueprintType)
+struct FHRFReferencePath
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	TArray<FName> Packages;
+};
+
+/* Something in the searched asset that causes a reference, e.g. a graph node or a property */
+USTRUCT(BlueprintType)
+struct FHRFSearchReference
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	FText Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	FText Tooltip;
+};
+
+/* A package referenced by the searched asset, along with where the references come from */
+USTRUCT(BlueprintType)
+struct FHRFSearchHeader
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	FName PackageName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	FName AssetClass;
+
+	/* Size of the package and everything it hard references */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	int64 Size = 0;
+
+	/* A single "Unidentified source" entry when the plugin couldn't tell where the reference comes from */
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	TArray<FHRFSearchReference> References;
+};
+
+/* The same results the Hard Reference Finder window shows for an asset */
+USTRUCT(BlueprintType)
+struct FHRFSearchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	FName PackageName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	int32 NumPackagesReferenced = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hard Reference Finder")
+	TArray<FHRFSearchHeader> Headers;
+};
+
+/*
+ * Hard reference queries for editor scripts and Editor Utility Blueprints, e.g. unreal.HardReferenceFinderLibrary in
+ * Python. Closure, referencer and path queries only read the asset registry. Batched calls read every result from one
+ * snapshot of the dependency graph and walk packages that share a closure once, so a batch costs about as much as
+ * the project heatmap rather than one full walk per package.
+ */
+UCLASS()
+class UHardReferenceFinderLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Hard Reference Finder")
+	static FHRFClosureInfo GetHardReferenceClosure(FName PackageName, bool bIncludePackages = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Hard Reference Finder")
+	static TArray<FHRFClosureInfo> GetHardReferenceClosures(const TArray<FName>& PackageNames, bool bIncludePackages = false);
+
+	/* Packages that directly hard reference a package */
+	UFUNCTION(BlueprintCallable, Category = "Hard Reference Finder")
+	static TArray<FName> GetHardReferencers(FName PackageName);
+
+	/* Up to MaxPaths of the shortest hard reference chains between two packages, shortest first */
+	UFUNCTION(BlueprintCallable, Category = "Hard Reference Finder")
+	static TArray<FHRFReferencePath> FindHardReferencePaths(FName FromPackage, FName ToPackage, int32 MaxPaths = 1);
+
+	/* Finds where an asset's references come from, this loads what the asset references like opening it would */
+	UFUNCTION(BlueprintCallable, Category = "Hard Reference Finder")
+	static FHRFSearchResult SearchAsset(UObject* Asset);
+
+	/* Class analyses and closure sizes are shared between the assets, so blueprints of one hierarchy are only scanned once */
+	UFUNCTION(BlueprintCallable, Category = "Hard Reference Finder")
+	static TArray<FHRFSearchResult> SearchAssets(const TArray<UObject*>& Assets);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UWorld;
+
+enum class EHRFLoadEventType : uint8
+{
+	/* A synchronous load of the package started, the game thread is blocked until it is loaded */
+	SyncLoadBegin,
+	/* An asset in the package finished loading, whether it was loaded synchronously or not */
+	Loaded,
+	/* An instance of the traced class was spawned, the package is the class' package */
+	InstanceSpawned,
+};
+
+struct FHRFLoadEvent
+{
+	FName PackageName = NAME_None;
+	double Time = 0.0;
+	EHRFLoadEventType Type = EHRFLoadEventType::Loaded;
+};
+
+/*
+ * Records every package load during the next PIE session, along with when instances of a class were spawned. Load
+ * callbacks only claim a slot in a fixed size buffer with an atomic increment and write into it, so recording
+ * doesn't lock or allocate while the game is loading. Events are read back once the session ends.
+ */
+class FHardReferenceFinderLoadTrace
+{
+public:
+	DECLARE_DELEGATE_TwoParams(FOnTraceFinished, const TArray<FHRFLoadEvent>& /*Events*/, int32 /*NumDropped*/);
+
+	~FHardReferenceFinderLoadTrace();
+
+	/* Waits for the next PIE session and records it until it ends */
+	void Arm(const UClass* InTracedClass);
+	void Disarm();
+	bool IsArmed() const { return bArmed; }
+	bool IsRecording() const { return bRecording; }
+
+	FOnTraceFinished OnTraceFinished;
+
+	/* Number of events kept per session, later events are dropped and counted */
+	static const int32 Capacity = 1 << 16;
+
+private:
+	struct FSlot
+	{
+		FHRFLoadEvent Event;
+		volatile int32 bPublished = 0;
+	};
+
+	void OnBeginPIE(bool bIsSimulating);
+	void OnPostPIEStarted(bool bIsSimulating);
+	void OnEndPIE(bool bIsSimulating);
+	void OnSyncLoadPackage(const FString& PackageName);
+	void OnAssetLoaded(UObject* Asset);
+	void OnActorSpawned(AActor* Actor);
+	void Record(FName PackageName, EHRFLoadEventType Type);
+	void StopRecording();
+
+	TWeakObjectPtr<const UClass> TracedClass;
+	TWeakObjectPtr<UWorld> TracedWorld;
+	FDelegateHandle ActorSpawnedHandle;
+	bool bArmed = false;
+	bool bRecording = false;
+
+	TArray<FSlot> Slots;
+	volatile int32 NextSlot = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
+
+/*
+ * Memory accounting for the plugin. Allocations are tracked by the Low-Level Memory Tracker under the
+ * HardReferenceFinder tag, with one sub-tag per subsystem (run the editor with -llm and use "stat LLMFULL"),
+ * and the live size of every cache is reported by "stat HardReferenceFinder".
+ */
+LLM_DECLARE_TAG(HardReferenceFinder);
+LLM_DECLARE_TAG(HardReferenceFinder_Search);
+LLM_DECLARE_TAG(HardReferenceFinder_Cache);
+LLM_DECLARE_TAG(HardReferenceFinder_Graph);
+LLM_DECLARE_TAG(HardReferenceFinder_History);
+LLM_DECLARE_TAG(HardReferenceFinder_Trace);
+LLM_DECLARE_TAG(HardReferenceFinder_UI);
+
+DECLARE_STATS_GROUP(TEXT("HardReferenceFinder"), STATGROUP_HardReferenceFinder, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Result Items"), STAT_HRF_NumResultItems, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Class Analyses"), STAT_HRF_NumClassAnalyses, STATGROUP_HardReferenceFinder, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Class Analysis Memory"), STAT_HRF_ClassAnalysisMemory, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Closure Sizes"), STAT_HRF_NumClosureSizes, STATGROUP_HardReferenceFinder, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Closure Size Memory"), STAT_HRF_ClosureSizeMemory, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Dependency Graph Packages"), STAT_HRF_NumGraphPackages, STATGROUP_HardReferenceFinder, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Dependency Graph Memory"), STAT_HRF_GraphMemory, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cooked Registries"), STAT_HRF_NumCookedRegistries, STATGROUP_HardReferenceFinder, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Cooked Registry Memory"), STAT_HRF_CookedRegistryMemory, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("History Samples"), STAT_HRF_NumHistorySamples, STATGROUP_HardReferenceFinder, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("History Memory"), STAT_HRF_HistoryMemory, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Scratch Allocations (Last Search)"), STAT_HRF_ScratchAllocations, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Searches"), STAT_HRF_NumPendingSearches, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Coalesced Searches"), STAT_HRF_NumCoalescedSearches, STATGROUP_HardReferenceFinder, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cook Report Blueprints"), STAT_HRF_NumCookReportBlueprints, STATGROUP_HardReferenceFinder, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cook Report Scan"), STAT_HRF_CookReportScan, STATGROUP_HardReferenceFinder, );
+
+/* Member of FHRFTreeViewItem that keeps the live item count up to date, copies included */
+struct FHRFResultItemStat
+{
+	FHRFResultItemStat() { INC_DWORD_STAT(STAT_HRF_NumResultItems); }
+	FHRFResultItemStat(const FHRFResultItemStat&) { INC_DWORD_STAT(STAT_HRF_NumResultItems); }
+	FHRFResultItemStat& operator=(const FHRFResultItemStat&) { return *this; }
+	~FHRFResultItemStat() { DEC_DWORD_STAT(STAT_HRF_NumResultItems); }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+
+class FJsonObject;
+class IHttpRouter;
+struct FHttpServerRequest;
+
+/*
+ * Opt-in JSON endpoint that lets build scripts query the running editor's dependency graph without launching a
+ * commandlet. Off by default, enable it with HardReferenceFinder.QueryService.Enable 1. Uses the engine's HTTP server,
+ * which listens on the address set by DefaultBindAddress or a per-port ListenerOverrides entry under
+ * [HTTPServer.Listeners] in the engine config, so it's only private to the machine when that is a loopback address.
+ *
+ * GET  /hardreferences?type=closure&package=/Game/Hero          single query from the url parameters
+ * POST /hardreferences {"queries": [{"type": "closure", ...}]}  batch of queries, answered in order
+ *
+ * Query types are "closure" (package), "referencers" (package) and "path" (from, to, maxPaths). Package lists are
+ * paged with offset and limit, each page reports the offset of the next one.
+ */
+class FHardReferenceFinderQueryService
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	~FHardReferenceFinderQueryService();
+
+private:
+	void OnSettingsChanged(IConsoleVariable* Variable);
+	void Start(int32 Port);
+	void Stop();
+
+	bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
+	TSharedRef<FJsonObject> RunQuery(const FJsonObject& Query) const;
+
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+	int32 ListeningPort = 0;
+
+	static TUniquePtr<FHardReferenceFinderQueryService> Instance;
+};
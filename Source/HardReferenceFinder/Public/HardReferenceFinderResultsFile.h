@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FHardReferenceFinderSnapshot;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/*
+ * On-disk layout of a results file. Every section is a flat array of fixed size records so that a reader can use the
+ * file straight out of a memory mapping, only touching the pages belonging to the blueprints it looks at.
+ *
+ *	FHeader
+ *	FBlueprintRecord[NumBlueprints]		sorted by blueprint package name
+ *	FPackageRecord[NumPackages]			grouped per blueprint
+ *	FSourceRecord[NumSources]			grouped per package
+ *	uint32 StringOffsets[NumStrings+1]	offsets into the string data, entry N+1 marks the end of string N
+ *	ANSICHAR StringData[] (UTF-8)
+ */
+namespace HardReferenceResultsFormat
+{
+	static constexpr uint32 Magic = 0x52465248; // 'HRFR'
+	static constexpr uint32 InvalidString = MAX_uint32;
+
+	enum class EVersion : uint32
+	{
+		Initial = 1,
+
+		// Blueprint records hold the blueprint's own closure size instead of the sum of its header sizes
+		ClosureSize,
+
+		// -----<new versions can be added above this line>-----
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumBlueprints;
+		uint32 NumPackages;
+		uint32 NumSources;
+		uint32 NumStrings;
+		uint64 BlueprintTableOffset;
+		uint64 PackageTableOffset;
+		uint64 SourceTableOffset;
+		uint64 StringOffsetsOffset;
+		uint64 StringDataOffset;
+		uint64 StringDataSize;
+	};
+
+	struct FBlueprintRecord
+	{
+		uint32 NameIndex;
+		uint32 FirstPackage;
+		uint32 NumPackages;
+		uint32 Reserved;
+
+		/* Size of the blueprint's own closure, zero when unknown */
+		int64 ClosureSize;
+	};
+
+	struct FPackageRecord
+	{
+		uint32 NameIndex;
+		uint32 FirstSource;
+		uint32 NumSources;
+		uint32 Reserved;
+
+		/* Size on disk of the header package itself */
+		int64 SizeOnDisk;
+	};
+
+	struct FSourceRecord
+	{
+		FGuid NodeGuid;
+		uint32 NameIndex;
+		uint32 SCSIdentifierIndex;
+	};
+
+	static_assert(sizeof(FHeader) % 8 == 0, "Sections following the header must stay 8 byte aligned");
+	static_assert(sizeof(FBlueprintRecord) == 24, "Changing record layouts requires a new format version");
+	static_assert(sizeof(FPackageRecord) == 24, "Changing record layouts requires a new format version");
+	static_assert(sizeof(FSourceRecord) == 24, "Changing record layouts requires a new format version");
+}
+
+/* Accumulates the results of one or more blueprints and writes them out as a single results file */
+class FHardReferenceFinderResultsWriter
+{
+public:
+	void AddBlueprint(const FHardReferenceFinderSnapshot& Snapshot);
+	bool SaveToFile(const FString& FileName);
+
+	int32 GetNumBlueprints() const { return Blueprints.Num(); }
+
+private:
+	uint32 AddString(const FString& String);
+
+	TArray<FString> Strings;
+	TMap<FString, uint32> StringToIndex;
+	TArray<HardReferenceResultsFormat::FBlueprintRecord> Blueprints;
+	TArray<HardReferenceResultsFormat::FPackageRecord> Packages;
+	TArray<HardReferenceResultsFormat::FSourceRecord> Sources;
+};
+
+/* Read-only view of a results file, backed by a memory mapping where the platform supports it */
+class FHardReferenceFinderResultsFile
+{
+public:
+	~FHardReferenceFinderResultsFile();
+
+	static TUniquePtr<FHardReferenceFinderResultsFile> Open(const FString& FileName);
+
+	int32 GetNumBlueprints() const;
+	FName GetBlueprintName(int32 BlueprintIndex) const;
+	int64 GetBlueprintClosureSize(int32 BlueprintIndex) const;
+	int32 FindBlueprint(FName BlueprintPackage) const;
+
+	/* Copies the records of a single blueprint out of the file */
+	bool ReadBlueprint(int32 BlueprintIndex, FHardReferenceFinderSnapshot& OutSnapshot) const;
+
+private:
+	FHardReferenceFinderResultsFile() = default;
+
+	bool Initialize();
+	FString GetString(uint32 StringIndex) const;
+	int32 CompareString(uint32 StringIndex, const FString& Other) const;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/* Used instead of the mapping on platforms that can't map files */
+	TArray<uint8> FallbackBytes;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	const HardReferenceResultsFormat::FHeader* Header = nullptr;
+	const HardReferenceResultsFormat::FBlueprintRecord* BlueprintTable = nullptr;
+	const HardReferenceResultsFormat::FPackageRecord* PackageTable = nullptr;
+	const HardReferenceResultsFormat::FSourceRecord* SourceTable = nullptr;
+	const uint32* StringOffsets = nullptr;
+	const ANSICHAR* StringData = nullptr;
+};
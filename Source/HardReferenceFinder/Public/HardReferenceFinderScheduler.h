@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HardReferenceFinderSearchData.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FBlueprintEditor;
+
+enum class EHRFSearchTarget : uint8
+{
+	Blueprint,
+	World,
+	Asset,
+};
+
+/* Requests are run in this order, requests that are only wanted by hidden tabs wait until one is shown */
+enum class EHRFSearchPriority : uint8
+{
+	Hidden,
+	Visible,
+	Focused,
+};
+
+/* What to search, requests that compare equal are run once and share their results */
+struct FHRFSearchRequest
+{
+	EHRFSearchTarget Target = EHRFSearchTarget::Blueprint;
+
+	/* The blueprint, world or asset being searched */
+	TWeakObjectPtr<UObject> Object;
+
+	/* Editor of Object, only used by blueprint searches */
+	TWeakPtr<FBlueprintEditor> BlueprintEditor;
+
+	/* Cooked platform to size headers with, none for editor sizes */
+	FName SizePlatform = NAME_None;
+
+	/* List soft dependencies after the hard references */
+	bool bIncludeSoftReferences = false;
+
+	bool operator==(const FHRFSearchRequest& Other) const
+	{
+		return Target == Other.Target && Object == Other.Object && SizePlatform == Other.SizePlatform && bIncludeSoftReferences == Other.bIncludeSoftReferences;
+	}
+};
+
+/* Everything a window shows from one search. Shared between every window that asked for it, so it's never modified. */
+struct FHRFSearchOutcome
+{
+	TArray<FHRFTreeViewItemPtr> Results;
+	int32 NumPackagesReferenced = 0;
+	int32 NumSoftPackagesReferenced = 0;
+	FName SizePlatform = NAME_None;
+	bool bUsingCookedSizes = false;
+	FString OwnChunkList;
+	int64 ForeignChunkSize = 0;
+	TSharedPtr<const FHRFClosureSize> SearchedClosure;
+};
+
+DECLARE_DELEGATE_RetVal(EHRFSearchPriority, FOnHRFGetSearchPriority);
+DECLARE_DELEGATE_OneParam(FOnHRFSearchFinished, TSharedRef<const FHRFSearchOutcome> /*Outcome*/);
+
+/*
+ * Runs the searches of every hard reference window in the editor. Windows queue requests rather than searching
+ * themselves, and the queue is worked through one search per editor tick on the game thread: requests of the
+ * focused window first, then of other visible windows, while requests that only hidden windows are waiting on are
+ * deferred until one of them is shown. Identical requests queued by several windows, or several times by one
+ * window, are searched once. Searches share FHardReferenceFinderCache, so closures and class analysis found for one
+ * window are reused by every other.
+ */
+class FHardReferenceFinderScheduler
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+	static FHardReferenceFinderScheduler& Get();
+
+	/* Null once the module has shut down, for widgets that may be destroyed after it */
+	static FHardReferenceFinderScheduler* TryGet() { return Instance.Get(); }
+
+	/*
+	 * Queues a search, replacing any search Owner is still waiting on. GetPriority is asked again every time the
+	 * queue is scheduled, and requests whose delegates are no longer bound are dropped.
+	 */
+	void RequestSearch(const void* Owner, const FHRFSearchRequest& Request, FOnHRFGetSearchPriority GetPriority, FOnHRFSearchFinished OnFinished);
+	void CancelSearches(const void* Owner);
+
+	int32 NumPendingSearches() const { return Jobs.Num(); }
+
+private:
+	struct FWaiter
+	{
+		const void* Owner = nullptr;
+		FOnHRFGetSearchPriority GetPriority;
+		FOnHRFSearchFinished OnFinished;
+	};
+
+	struct FJob
+	{
+		FHRFSearchRequest Request;
+		TArray<FWaiter> Waiters;
+	};
+
+	bool Tick(float DeltaTime);
+	void DropUnwantedJobs();
+	TSharedRef<const FHRFSearchOutcome> RunSearch(const FHRFSearchRequest& Request);
+	void UpdateStats() const;
+
+	/* Pending jobs in the order they were requested, ties in priority are run oldest first */
+	TArray<FJob> Jobs;
+
+	/* Reused by every search so their scratch storage is only grown once */
+	FHardReferenceFinderSearchData SearchData;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FDelegateHandle TickerHandle;
+#else
+	FTSTicker::FDelegateHandle TickerHandle;
+#endif
+
+	static TUniquePtr<FHardReferenceFinderScheduler> Instance;
+};
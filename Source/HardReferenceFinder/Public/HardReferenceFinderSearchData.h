@@ -2,67 +2,260 @@
 
 #include "CoreMinimal.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "HardReferenceFinderMemory.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Templates/SharedPointer.h"
 #include "Textures/SlateIcon.h"
 
 class FBlueprintEditor;
+class FHardReferenceFinderCookedRegistry;
 class UEdGraph;
 class UEdGraphNode;
 class UK2Node_FunctionEntry;
+class AActor;
 class USCS_Node;
+class UDataTable;
+class UMaterial;
+class UMaterialInstance;
+class UWidgetBlueprint;
+class UWorld;
+struct FHRFClassAnalysis;
+struct FHRFClosureSize;
+
+enum class EHRFDiffState : uint8
+{
+	None,
+	Unchanged,
+	Added,
+	Removed,
+	Changed,
+};
+
+/* How ResolveDisplayInfo builds the name and icon of a result from the identifiers recorded during the search */
+enum class EHRFDisplayKind : uint8
+{
+	/* Name and icon were set during the search */
+	Resolved,
+	/* Title and icon of SourceNode */
+	GraphNode,
+	/* The input pin SourceName on SourceNode */
+	GraphPin,
+	/* NameFormat applied to SourceName and SourceContext, icon of SourceClass when set */
+	Named,
+	/* As Named, with the icon of the component class SourceClass */
+	Component,
+	/* As Named, colored by the type of the blueprint variable SourceName declared in SourceClass */
+	Variable,
+	/* NameFormat applied to the label of the actor SourceObject, SourceName and SourceContext, icon of SourceClass when set */
+	PlacedActor,
+};
 
 class FHRFTreeViewItem : public TSharedFromThis<FHRFTreeViewItem>
 {
 public:
+	/*
+	 * Fills in Name, SlateIcon and IconColor for results that were recorded without them, see DisplayKind. With
+	 * bNameOnly only Name is filled in and the result stays unresolved, so its icon is still looked up once displayed.
+	 */
+	void ResolveDisplayInfo(bool bNameOnly = false);
+	void SetDeferredName(EHRFDisplayKind InDisplayKind, const FText& InNameFormat, FName InSourceName, FName InSourceContext = NAME_None, const UClass* InSourceClass = nullptr);
 
 	bool bIsHeader = false;
-	int SizeOnDisk = 0;
+
+	/* Set on soft referenced headers and their sources, which are listed after every hard reference */
+	bool bIsSoftReference = false;
+
+	/* A soft referenced header whose package is in the hard closure anyway, so resolving it loads nothing more */
+	bool bIsEffectivelyHard = false;
+
+	/* The placeholder added under a header when no source of the reference could be identified */
+	bool bIsUnidentifiedSource = false;
+
+	int64 SizeOnDisk = 0;
 	FName PackageId = NAME_None;
+	FName AssetClass = NAME_None;
 	FText Name;
 	FText Tooltip;
 	FGuid NodeGuid;
 	FName SCSIdentifier = NAME_None;
+	TWeakObjectPtr<UObject> SourceObject;
+	
+	/* Searches only record these identifiers, titles and icons are looked up once a row is first displayed */
+	EHRFDisplayKind DisplayKind = EHRFDisplayKind::Resolved;
+	TWeakObjectPtr<const UEdGraphNode> SourceNode;
+	TWeakObjectPtr<const UClass> SourceClass;
+	FName SourceName = NAME_None;
+	FName SourceContext = NAME_None;
+	FText NameFormat;
+
 	FSlateIcon SlateIcon;
 	FLinearColor IconColor = FLinearColor::White;
+	EHRFDiffState DiffState = EHRFDiffState::None;
+	int64 SizeDelta = 0;
 	TArray<TSharedPtr<FHRFTreeViewItem>> Children;
+
+	/* Chunks the closure of a header pulls in when sized from a cooked registry, e.g. "0, 3" */
+	FString Chunks;
+
+	/* What the closure of a header is made of, grouped by asset class and by folder. Shown after the children. */
+	TArray<TSharedPtr<FHRFTreeViewItem>> Breakdown;
+
+private:
+	FHRFResultItemStat ItemStat;
 };
 typedef TSharedPtr<FHRFTreeViewItem> FHRFTreeViewItemPtr;
 
-#if ENGINE_MAJOR_VERSION < 5
-typedef const TArray<UEdGraph*> FEdGraphArray;
-#else
-typedef const TArray<TObjectPtr<UEdGraph>> FEdGraphArray;
-#endif
+/*
+ * Packages found by property walks. Collectors are owned by the search data and reused by every search, Reset() keeps
+ * their storage, so walks only allocate while a collector grows past anything it held before. Packages are
+ * deduplicated through a bitset indexed by object index. Soft referenced packages may not be loaded and are collected
+ * by name alongside, deduplicated through a set. A collector is only ever used by one thread at a time.
+ */
+class FHRFPackageCollector
+{
+public:
+	explicit FHRFPackageCollector(FThreadSafeCounter& InNumAllocations) : NumAllocations(InNumAllocations) {}
+
+	void Add(UPackage* Package);
+	void AddSoft(FName PackageName);
+	void Reset();
+	const TArray<UPackage*>& GetPackages() const { return Packages; }
+	const TArray<FName>& GetSoftPackages() const { return SoftPackages; }
+
+	/* FProperty::ContainsObjectReference with a reused list of visited structs */
+	bool ContainsStrongObjectReference(const FProperty* Property);
+
+private:
+	TArray<UPackage*> Packages;
+	TBitArray<> SeenPackages;
+	TArray<FName> SoftPackages;
+	TSet<FName> SeenSoftPackages;
+
+	/* ContainsObjectReference only accepts a heap array, it's reset rather than freed between properties */
+	TArray<const FStructProperty*> EncounteredStructProps;
+
+	/* Incremented whenever any of the storage above is reallocated */
+	FThreadSafeCounter& NumAllocations;
+};
 
 class FHardReferenceFinderSearchData
 {
 public:
+	FHardReferenceFinderSearchData();
+
 	TArray<FHRFTreeViewItemPtr> GatherSearchData(TWeakPtr<FBlueprintEditor> BlueprintEditor);
+	TArray<FHRFTreeViewItemPtr> GatherSearchDataForWorld(UWorld* World);
+	TArray<FHRFTreeViewItemPtr> GatherSearchDataForAsset(UObject* Asset);
+
+	int GetNumPackagesReferenced() const { return NumPackagesReferenced; }
+
+	/* Also list the soft dependencies of the searched asset, after its hard references. Applies to the next search. */
+	void SetIncludeSoftReferences(bool bInclude) { bIncludeSoftReferences = bInclude; }
+	bool IsIncludingSoftReferences() const { return bIncludeSoftReferences; }
+	int32 GetNumSoftPackagesReferenced() const { return NumSoftPackagesReferenced; }
+
+	/*
+	 * Only attribute references to their sources, for searches whose results are never displayed. Headers are left
+	 * unsized and without asset data, icons or closure breakdowns, and no total closure header is added. Applies to
+	 * the next search.
+	 */
+	void SetSourcesOnly(bool bInSourcesOnly) { bSourcesOnly = bInSourcesOnly; }
+	bool IsSourcesOnly() const { return bSourcesOnly; }
+
+	/* Size headers with the cooked sizes of a platform, or with editor sizes when none. Applies to the next search. */
+	void SetSizePlatform(FName PlatformName) { SizePlatform = PlatformName; }
+	FName GetSizePlatform() const { return SizePlatform; }
 
-	int GetNumPackagesReferenced() const { return TreeView.Num(); }
+	/* True when the last search used cooked sizes, false when the platform had no cooked registry */
+	bool IsUsingCookedSizes() const { return CookedRegistry.IsValid(); }
+
+	/* Chunks of the searched asset itself, and the bytes its closure pulls in from packages outside those chunks */
+	const FString& GetOwnChunkList() const { return OwnChunkList; }
+	int64 GetForeignChunkSize() const { return ForeignChunkSize; }
+
+	/* Closure of the searched asset itself, null when the last search had no package */
+	TSharedPtr<const FHRFClosureSize> GetSearchedClosure() const { return SearchedClosure; }
+
+	/* Times the last search had to grow its scratch storage, zero once earlier searches have grown it large enough */
+	int32 GetNumScratchAllocations() const { return NumScratchAllocations.GetValue(); }
 
 private:	
 	void Reset();
+	void AddPackageHeaders(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, FAssetRegistryModule& AssetRegistryModule, const TArray<FName>& PackageNames);
+	void AddSoftPackageHeaders(FAssetRegistryModule& AssetRegistryModule, const TArray<FName>& RootPackages);
+	FHRFTreeViewItemPtr MakePackageHeader(FName PathName, const FAssetData& AssetData, FAssetRegistryModule& AssetRegistryModule) const;
+	void FinalizeSearchResults(FAssetRegistryModule& AssetRegistryModule, FName SearchedPackage);
 	UObject* GetObjectContext(TWeakPtr<FBlueprintEditor> BlueprintEditor) const;
 	void GetBlueprintDependencies(TArray<FName>& OutPackageDependencies, FAssetRegistryModule& AssetRegistryModule, TWeakPtr<FBlueprintEditor> BlueprintEditor) const;
-	void SearchGraphNodes(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const FEdGraphArray& EdGraphList) const;
-	void SearchNodePins(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UEdGraphNode* Node) const;
+	void GetPackageDependencies(TArray<FName>& OutPackageDependencies, FAssetRegistryModule& AssetRegistryModule, FName PackageName) const;
+	void SearchBlueprint(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, UBlueprint* Blueprint) const;
+	void SearchPlacedActors(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UWorld* World) const;
+	/*
+	 * Results are named SourceName.Property. When SourceObject is a placed actor they are named after its label
+	 * instead, with SourceName as the component the property belongs to, if any. Labels are only looked up when a row
+	 * is displayed. SkippedProperties are already attributed by a dedicated scanner and are left out of the walk.
+	 */
+	void SearchObjectProperties(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UObject* Object, const UObject* Archetype, UObject* SourceObject, FName SourceName, const FText& Tooltip, TArrayView<const FName> SkippedProperties = TArrayView<const FName>()) const;
+	void SearchDataTable(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UDataTable* DataTable) const;
+	/*
+	 * Walks every property of a struct value, recursing into nested structs and arrays of structs. InOutPath holds the
+	 * properties leading to the struct, with the element index of those that are arrays, and is passed to OnReference
+	 * extended by the property each reference was found in. Only reads the value, so it is safe on worker threads.
+	 */
+	void FindPackagesInStruct(FHRFPackageCollector& OutReferencedPackages, TArray<TPair<const FProperty*, int32>>& InOutPath, const UStruct* Struct, const void* ContainerPtr, TFunctionRef<void(FName PackageName, const TArray<TPair<const FProperty*, int32>>& Path, const FSlateIcon& Icon, bool bIsSoft)> OnReference) const;
+	void SearchMaterialInstance(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UMaterialInstance* MaterialInstance) const;
+	void SearchMaterial(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UMaterial* Material) const;
+	void SearchWorldPartitionActors(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, FAssetRegistryModule& AssetRegistryModule, UWorld* World);
+	void SearchGraphNodes(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const TArray<const UEdGraphNode*>& Nodes) const;
 	void SearchBlueprintClassProperties(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, UBlueprint* Blueprint) const;
 	void SearchFunctionReferences(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UBlueprint* Blueprint) const;
 	void SearchSimpleConstructionScript(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UBlueprint* Blueprint) const;
+	void SearchWidgetTree(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UWidgetBlueprint* WidgetBlueprint) const;
+
+	void AnalyzeClassProperties(FHRFClassAnalysis& OutAnalysis, const UClass* Class) const;
 
 	UK2Node_FunctionEntry* FindGraphNodeForFunction(const UBlueprint* Blueprint, UFunction* FunctionToFind) const;
-	void FindPackagesInSCSNode(TSet<UPackage*>& OutReferencedPackages,const USCS_Node* SCSNode) const;
-	TArray<UPackage*> FindPackagesForProperty(FSlateIcon& OutResultIcon, const UObject* ContainerPtr, const FProperty* TargetProperty) const;
+	void FindPackagesInSCSNode(FHRFPackageCollector& OutReferencedPackages, const USCS_Node* SCSNode) const;
+	void FindPackagesForProperty(FHRFPackageCollector& OutReferencedPackages, FSlateIcon& OutResultIcon, const void* ContainerPtr, const FProperty* TargetProperty) const;
+	void FindSoftPackagesForProperty(FHRFPackageCollector& OutReferencedPackages, FSlateIcon& OutResultIcon, const void* ContainerPtr, const FProperty* TargetProperty) const;
+	FHRFPackageCollector& GetScratchPackages() const;
 	FHRFTreeViewItemPtr CheckAddPackageResult(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, const UPackage* Package) const;
+	FHRFTreeViewItemPtr CheckAddPackageResult(TMap<FName, FHRFTreeViewItemPtr>& OutPackageMap, const FAssetRegistryModule& AssetRegistryModule, FName PackageName) const;
+	FHRFTreeViewItemPtr CheckAddSoftPackageResult(FName PackageName) const;
 	
 	void GetAssetForPackages(const TArray<FName>& PackageNames, TMap<FName, FAssetData>& OutPackageToAssetData) const;
 	bool TryGetAssetPackageData(FName PathName, FAssetPackageData& OutPackageData, const FAssetRegistryModule& AssetRegistryModule) const;
 	FString GetAssetTypeName(const FAssetData& AssetData) const;
 	FAssetData GetAssetDataForObject(const UObject* Object) const;
-	int64 GatherAssetSizeByName(const FName& AssetName, FAssetRegistryModule& AssetRegistryModule) const;
-	int64 GatherAssetSizeRecursive(const FName& OutFrontier, TSet<FName>& OutVisited, FAssetRegistryModule& AssetRegistryModule) const;
+	TSharedRef<const FHRFClosureSize> GatherClosureSize(const FName& AssetName, FAssetRegistryModule& AssetRegistryModule) const;
+	/* Sizes every package in the hard closure of AssetName into OutVisited and returns their total */
+	int64 GatherClosurePackages(const FName& AssetName, TMap<FName, int64>& OutVisited, FAssetRegistryModule& AssetRegistryModule) const;
+	int64 GetPackageSize(FName PackageName, const FAssetRegistryModule& AssetRegistryModule) const;
+	void AddClosureBreakdown(FHRFTreeViewItem& OutHeader, const FHRFClosureSize& ClosureSize) const;
 	
 	TArray<FHRFTreeViewItemPtr> TreeView;
+	int32 NumPackagesReferenced = 0;
+	bool bSourcesOnly = false;
+
+	/* Soft referenced packages of the running search, kept apart so a package can be both hard and soft referenced */
+	bool bIncludeSoftReferences = false;
+	TMap<FName, FHRFTreeViewItemPtr> SoftPackageMap;
+	TArray<FHRFTreeViewItemPtr> SoftTreeView;
+	int32 NumSoftPackagesReferenced = 0;
+
+	FName SizePlatform = NAME_None;
+	TSharedPtr<const FHardReferenceFinderCookedRegistry> CookedRegistry;
+	FString OwnChunkList;
+	int64 ForeignChunkSize = 0;
+	TSharedPtr<const FHRFClosureSize> SearchedClosure;
+
+	mutable FThreadSafeCounter NumScratchAllocations;
+
+	/* Kept between searches along with their storage. ScratchPackages is only set inside GatherSearchData*(). */
+	FHRFPackageCollector SearchPackages;
+	FHRFPackageCollector* ScratchPackages = nullptr;
+
+	/* One per worker walking data table rows, grown to the most workers any table needed */
+	mutable TArray<TUniquePtr<FHRFPackageCollector>> WorkerPackages;
 };
 
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HardReferenceFinderSearchData.h"
+
+struct FHRFSnapshotSource
+{
+	FString Name;
+	FGuid NodeGuid;
+	FName SCSIdentifier = NAME_None;
+};
+
+struct FHRFSnapshotPackage
+{
+	FName PackageId = NAME_None;
+	int64 SizeOnDisk = 0;
+	TArray<FHRFSnapshotSource> Sources;
+};
+
+/*
+ * A saved copy of the results of a search, used as the baseline when diffing two revisions of a blueprint.
+ * Snapshots are stored in the binary results file format, see FHardReferenceFinderResultsFile.
+ */
+class FHardReferenceFinderSnapshot
+{
+public:
+	FHardReferenceFinderSnapshot() = default;
+	FHardReferenceFinderSnapshot(FName InBlueprintPackage, TArray<FHRFSnapshotPackage>&& InPackages, int64 InClosureSize = 0);
+
+	/* ClosureSize is the size of the searched asset's own closure, see FHardReferenceFinderSearchData::GetSearchedClosure */
+	static FHardReferenceFinderSnapshot FromSearchResults(FName InBlueprintPackage, const TArray<FHRFTreeViewItemPtr>& Results, int64 ClosureSize);
+
+	bool SaveToFile(const FString& FileName) const;
+
+	/* Loads the entry for BlueprintPackage, or the only entry in the file when it holds a single blueprint */
+	bool LoadFromFile(const FString& FileName, FName BlueprintPackage);
+
+	/* Marks added/changed headers in InOutResults and appends headers for packages that are no longer referenced */
+	void ApplyDiff(TArray<FHRFTreeViewItemPtr>& InOutResults) const;
+
+	bool IsValid() const { return BlueprintPackage != NAME_None; }
+	FName GetBlueprintPackage() const { return BlueprintPackage; }
+	const TArray<FHRFSnapshotPackage>& GetPackages() const { return Packages; }
+
+	/* Size of the blueprint's own closure, zero when the snapshot was saved without one */
+	int64 GetClosureSize() const { return ClosureSize; }
+
+private:
+	FName BlueprintPackage = NAME_None;
+	TArray<FHRFSnapshotPackage> Packages;
+	int64 ClosureSize = 0;
+};
@@ -9,7 +9,12 @@ struct FHardReferenceFinderSummoner : public FWorkflowTabFactory
 {
 	FHardReferenceFinderSummoner(TSharedPtr<class FAssetEditorToolkit> InHostingApp);
 
+	virtual TSharedRef<SDockTab> SpawnTab(const FWorkflowTabSpawnInfo& Info) const override;
 	virtual TSharedRef<SWidget> CreateTabBody(const FWorkflowTabSpawnInfo& Info) const override;
 
 	virtual FText GetTabToolTipText(const FWorkflowTabSpawnInfo& Info) const override;
+
+private:
+	/* The body created for the tab being spawned, told about its tab once SpawnTab has made it */
+	mutable TWeakPtr<class SHardReferenceFinderWindow> SpawningWindow;
 };
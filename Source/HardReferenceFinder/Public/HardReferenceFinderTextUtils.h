@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace HardReferenceInternals
+{
+	inline FText MakeBestSizeString(const SIZE_T SizeInBytes)
+	{
+		FText SizeText;
+
+		if (SizeInBytes < 1000)
+		{
+			// We ended up with bytes, so show a decimal number
+			SizeText = FText::AsMemory(SizeInBytes, EMemoryUnitStandard::SI);
+		}
+		else
+		{
+			// Show a fractional number with the best possible units
+			FNumberFormattingOptions NumberFormattingOptions;
+			NumberFormattingOptions.MaximumFractionalDigits = 1;
+			NumberFormattingOptions.MinimumFractionalDigits = 0;
+			NumberFormattingOptions.MinimumIntegralDigits = 1;
+
+			SizeText = FText::AsMemory(SizeInBytes, &NumberFormattingOptions, nullptr, EMemoryUnitStandard::SI);
+		}
+
+		return SizeText;
+	}
+
+	inline FText MakeSizeDeltaString(const int64 SizeDelta)
+	{
+		const FText SizeText = MakeBestSizeString(FMath::Abs(SizeDelta));
+		return SizeDelta < 0
+			? FText::Format(NSLOCTEXT("FHardReferenceFinderModule", "NegativeSizeDelta", "-{0}"), SizeText)
+			: FText::Format(NSLOCTEXT("FHardReferenceFinderModule", "PositiveSizeDelta", "+{0}"), SizeText);
+	}
+}
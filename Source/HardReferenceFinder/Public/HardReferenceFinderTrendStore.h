@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+/* The closure of a blueprint at the time it was analyzed */
+struct FHRFTrendSample
+{
+	/* Unix time in seconds */
+	int64 Timestamp = 0;
+
+	/* Changelist passed with -HardReferenceChangelist=, 0 when unknown */
+	int32 Changelist = 0;
+
+	int64 TotalSize = 0;
+	int32 NumPackages = 0;
+
+	/* The largest direct references and their closure sizes, largest first */
+	TArray<TPair<FName, int64>> TopHeaders;
+};
+
+/*
+ * History of every blueprint's closure size, kept in an append-only file under Saved/HardReferenceFinder. Samples
+ * are stored as variable length deltas from the previous sample of the same blueprint and package names are written
+ * once, so months of history stay small. The file is read once into memory and only appended to afterwards.
+ *
+ * Several editors and commandlets may share the file. Appends hold the file open for exclusive writing and first read
+ * whatever other processes appended since, so string ids and deltas always follow the file rather than this process.
+ * A record that can't be read is never rewritten: reading stops there, and appending stops if it's still incomplete
+ * once the file is held exclusively, since only a writer that crashed mid-record leaves one behind.
+ *
+ *	uint32 Magic, uint32 Version
+ *	repeated:
+ *		uint8 StringTag,  varint Length, UTF-8 Characters[Length]					defines the next string id
+ *		uint8 SampleTag,  varint BlueprintString, zigzag TimestampDelta, zigzag ChangelistDelta,
+ *		                  zigzag TotalSizeDelta, zigzag NumPackagesDelta,
+ *		                  varint NumTopHeaders, { varint PackageString, varint Size }[NumTopHeaders]
+ */
+class FHardReferenceFinderTrendStore
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+	static FHardReferenceFinderTrendStore& Get();
+
+	explicit FHardReferenceFinderTrendStore(const FString& InStorePath = GetStorePath());
+
+	static FString GetStorePath();
+
+	/*
+	 * Changelist recorded with new samples, from -HardReferenceChangelist= on the command line. Build agents know which
+	 * changelist they synced, an editor launched without it records 0 and its samples are only shown by time.
+	 */
+	static int32 GetCurrentChangelist();
+
+	/* Appends a sample, skipped when nothing changed since the blueprint's previous sample */
+	void Record(FName BlueprintPackage, const FHRFTrendSample& Sample);
+
+	/* Samples of a blueprint, oldest first, including those other processes appended since the last call */
+	const TArray<FHRFTrendSample>& GetHistory(FName BlueprintPackage);
+
+	/* Indices of the samples whose size grew the most since the sample before them, largest growth first */
+	static TArray<int32> FindBiggestRegressions(const TArray<FHRFTrendSample>& History, int32 MaxRegressions);
+
+private:
+	enum class EReadResult : uint8
+	{
+		/* Everything up to the end of the file was read */
+		Complete,
+		/* Reading stopped at a record that is incomplete or unreadable */
+		IncompleteTail,
+		/* The file isn't a closure history this version can read */
+		BadHeader,
+	};
+
+	void LoadIfNeeded();
+	void RefreshFromFile();
+	EReadResult ReadNewRecords(IFileHandle& File);
+	int64 ParseRecords(const uint8* Data, int64 NumBytes);
+	void ResetContents();
+	uint32 FindOrAddString(FName String, TArray<uint8>& OutRecords);
+	void UpdateStats() const;
+
+	FString StorePath;
+	bool bIsLoaded = false;
+
+	/* Cleared when the store can't be appended to without adding unreadable data, see the class comment */
+	bool bIsWritable = true;
+	bool bHasWarnedIncompleteTail = false;
+
+	/* Bytes of the file read so far, always the end of a complete record. 0 until the header was read. */
+	int64 ReadOffset = 0;
+
+	TMap<FName, TArray<FHRFTrendSample>> Histories;
+	TArray<FName> Strings;
+	TMap<FName, uint32> StringIds;
+
+	static TUniquePtr<FHardReferenceFinderTrendStore> Instance;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+/* One of the assets analyzed together, with how much of its closure no other selected asset pulls in */
+struct FHRFAggregateAsset
+{
+	FAssetData AssetData;
+	FText Name;
+	int32 GraphIndex = INDEX_NONE;
+	int64 ClosureSize = 0;
+	int64 UniqueSize = 0;
+	int64 SharedSize = 0;
+};
+typedef TSharedPtr<FHRFAggregateAsset> FHRFAggregateAssetPtr;
+
+/* A package in the combined closure and how many of the selected assets hard reference it */
+struct FHRFAggregatePackage
+{
+	FName PackageName = NAME_None;
+	int64 DiskSize = 0;
+	int32 RefCount = 0;
+};
+typedef TSharedPtr<FHRFAggregatePackage> FHRFAggregatePackagePtr;
+
+/*
+ * The combined hard reference closure of a set of assets selected in the Content Browser, e.g. every enemy spawned
+ * in one encounter. Closures are read from the shared dependency graph, so none of the assets are loaded.
+ */
+class SHardReferenceFinderAggregate : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SHardReferenceFinderAggregate) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/* Replaces the analyzed assets and measures them */
+	void SetAssets(const TArray<FAssetData>& InAssets);
+
+	static const FName ColumnAsset;
+	static const FName ColumnClosureSize;
+	static const FName ColumnUniqueSize;
+	static const FName ColumnSharedSize;
+	static const FName ColumnPackage;
+	static const FName ColumnRefCount;
+	static const FName ColumnPackageSize;
+
+private:
+	void RebuildAggregate();
+	FReply OnRefreshClicked();
+	void OnDoubleClickAsset(FHRFAggregateAssetPtr Item) const;
+	TSharedRef<ITableRow> OnGenerateAssetRow(FHRFAggregateAssetPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const;
+	TSharedRef<ITableRow> OnGeneratePackageRow(FHRFAggregatePackagePtr Item, const TSharedRef<STableViewBase>& OwnerTable) const;
+
+	/* Assets selected when the view was opened */
+	TArray<FAssetData> SelectedAssets;
+
+	/* Selected assets found in the dependency graph, largest closure first */
+	TArray<FHRFAggregateAssetPtr> Assets;
+
+	/* Every package in the combined closure, most shared first */
+	TArray<FHRFAggregatePackagePtr> Packages;
+
+	TSharedPtr<STextBlock> SummaryText;
+	TSharedPtr<SListView<FHRFAggregateAssetPtr>> AssetList;
+	TSharedPtr<SListView<FHRFAggregatePackagePtr>> PackageList;
+};
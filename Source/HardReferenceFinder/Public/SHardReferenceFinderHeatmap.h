@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Future.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+
+class FHardReferenceFinderDependencyGraph;
+class STreeMap;
+struct FTreeMapNodeData;
+
+/* A blueprint in the project along with the size of everything it hard references */
+struct FHRFHeatmapItem
+{
+	FAssetData AssetData;
+	FText Name;
+	int32 GraphIndex = INDEX_NONE;
+	int32 NumDependencies = 0;
+	int64 ClosureSize = 0;
+};
+typedef TSharedPtr<FHRFHeatmapItem> FHRFHeatmapItemPtr;
+
+/*
+ * Project wide overview of every blueprint's hard references. Everything is computed from the asset registry, so
+ * no blueprint is loaded until one is opened from the list. The dependency graph and the closure sizes are built on
+ * worker threads, a throbber is shown until they are ready.
+ */
+class SHardReferenceFinderHeatmap : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SHardReferenceFinderHeatmap) {}
+	SLATE_END_ARGS()
+
+	virtual ~SHardReferenceFinderHeatmap() override;
+
+	void Construct(const FArguments& InArgs);
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	static const FName ColumnName;
+	static const FName ColumnDependencies;
+	static const FName ColumnClosureSize;
+
+private:
+	void RebuildHeatmap();
+	void OnDependencyGraphBuilt(TSharedRef<const FHardReferenceFinderDependencyGraph> Graph);
+	void OnClosureSizesMeasured(const TArray<int64>& ClosureSizes);
+	bool IsIdle() const;
+	EVisibility GetThrobberVisibility() const;
+	void SortItems();
+	void RebuildTreeMap();
+	FReply OnRefreshClicked();
+	void OnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+	EColumnSortMode::Type GetSortMode(FName ColumnId) const;
+	void OnDoubleClickItem(FHRFHeatmapItemPtr Item) const;
+	TSharedRef<ITableRow> OnGenerateRow(FHRFHeatmapItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const;
+
+	/* Every blueprint found in the registry */
+	TArray<FHRFHeatmapItemPtr> Items;
+
+	/*
+	 * Blueprints whose closures are being measured on a worker. The worker only gets a raw pointer to the graph and the
+	 * graph indices, PendingGraph keeps the graph alive until it's done.
+	 */
+	TArray<FHRFHeatmapItemPtr> PendingItems;
+	TSharedPtr<const FHardReferenceFinderDependencyGraph> PendingGraph;
+	TFuture<TArray<int64>> PendingClosureSizes;
+
+	/* Set from the start of a rebuild until its results are shown, refreshing is disabled meanwhile */
+	bool bIsBuilding = false;
+
+	FName SortColumn;
+	EColumnSortMode::Type SortMode = EColumnSortMode::Descending;
+
+	TSharedPtr<STextBlock> SummaryText;
+	TSharedPtr<SListView<FHRFHeatmapItemPtr>> ListView;
+	TSharedPtr<STreeMap> TreeMap;
+	TSharedPtr<FTreeMapNodeData> TreeMapRoot;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HardReferenceFinderSearchData.h"
+#include "Widgets/SLeafWidget.h"
+
+class SGraphPanel;
+
+/* Hard reference size attributed to one graph node, along with the badge text drawn for it */
+struct FHRFNodeCost
+{
+	/* Bytes of the node's closure nothing else in the blueprint pulls in, removing the node stops them from loading */
+	int64 UniqueSize = 0;
+
+	/* Bytes of the node's closure other nodes, variables or components pull in as well */
+	int64 SharedSize = 0;
+
+	FText BadgeText;
+
+	/* Measured once when the costs are built, badges are painted every frame */
+	FVector2D TextSize = FVector2D::ZeroVector;
+};
+
+/*
+ * Costs of every node listed in a window's results keyed by NodeGuid. Built at most once per search so badges are
+ * drawn from a lookup rather than from the search data. Every node is a source, and everything else referencing
+ * packages (variables, components, parent classes) counts as one more. The closure of a source is the union of the
+ * closures of its packages, measured with editor sizes on the condensed dependency graph like the aggregate view, so
+ * overlap between packages is only counted once.
+ */
+struct FHRFNodeCosts
+{
+	/* Keeps the results of a search, their costs are only measured once badges are visible */
+	void SetResults(const TArray<FHRFTreeViewItemPtr>& SearchResults);
+
+	/* Measures the costs of the current results unless that was already done, this needs the project dependency graph */
+	void BuildIfNeeded();
+
+	TMap<FGuid, FHRFNodeCost> Costs;
+	bool bVisible = false;
+
+private:
+	TArray<FHRFTreeViewItemPtr> Results;
+	bool bIsBuilt = false;
+};
+
+/*
+ * Draws a badge above each node of a graph panel that has an entry in FHRFNodeCosts. Added on top of the panel in
+ * the graph editor's overlay, it takes no input and only walks the cost map while painting.
+ */
+class SHardReferenceFinderNodeCosts : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SHardReferenceFinderNodeCosts) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, TSharedRef<SGraphPanel> InGraphPanel, TSharedRef<const FHRFNodeCosts> InCosts);
+	void SetCosts(TSharedRef<const FHRFNodeCosts> InCosts);
+
+	/* Adds an overlay to every graph panel below Root that doesn't have one yet, and points existing ones at Costs */
+	static void AttachToGraphPanels(const TSharedRef<SWidget>& Root, TSharedRef<const FHRFNodeCosts> Costs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	EVisibility GetOverlayVisibility() const;
+	const FSlateBrush* GetBrush_Badge() const;
+
+	TWeakPtr<SGraphPanel> GraphPanel;
+	TWeakPtr<const FHRFNodeCosts> Costs;
+};
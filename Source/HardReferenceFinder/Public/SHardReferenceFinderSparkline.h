@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+/* Small line chart of a series of values, scaled to fill the widget */
+class SHardReferenceFinderSparkline : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SHardReferenceFinderSparkline)
+		: _DesiredSize(FVector2D(120.f, 18.f))
+		, _LineColor(FLinearColor(0.9f, 0.5f, 0.1f))
+	{}
+		SLATE_ARGUMENT(FVector2D, DesiredSize)
+		SLATE_ARGUMENT(FLinearColor, LineColor)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	void SetValues(TArray<double>&& InValues);
+	int32 NumValues() const { return Values.Num(); }
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	TArray<double> Values;
+	FVector2D DesiredSize;
+	FLinearColor LineColor;
+};
@@ -1,27 +1,79 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "HardReferenceFinderFilter.h"
+#include "HardReferenceFinderLoadTrace.h"
+#include "HardReferenceFinderScheduler.h"
 #include "HardReferenceFinderSearchData.h"
+#include "HardReferenceFinderSnapshot.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Input/SComboBox.h"
 #include "Widgets/Views/STableViewBase.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/STreeView.h"
 
 class FBlueprintEditor;
+class SDockTab;
+class SHardReferenceFinderSparkline;
+struct FHRFNodeCosts;
 
 class SHardReferenceFinderWindow : public SCompoundWidget
 {
-	SLATE_BEGIN_ARGS(SHardReferenceFinderWindow) {};
+	SLATE_BEGIN_ARGS(SHardReferenceFinderWindow)
+		: _AnalyzeEditorWorld(false)
+		, _Asset(nullptr)
+	{};
+		/* Analyze the level open in the level editor instead of a blueprint */
+		SLATE_ARGUMENT(bool, AnalyzeEditorWorld)
+		/* Analyze a non-blueprint asset, e.g. a data table or material, instead of a blueprint */
+		SLATE_ARGUMENT(UObject*, Asset)
 	SLATE_END_ARGS()
 
+	virtual ~SHardReferenceFinderWindow() override;
 	void Construct(const FArguments& InArgs, TSharedPtr<FBlueprintEditor> InBlueprintGraph);
 
+	/* The tab the window was spawned in, its visibility decides how soon the window's searches run */
+	void SetOwnerTab(const TSharedRef<SDockTab>& InOwnerTab);
+
 private:
 	typedef STreeView<FHRFTreeViewItemPtr> SHRFTreeType;
 	
 	TSet<FName> GetCollapsedPackages() const;
 	void InitiateSearch();
+	void OnSearchFinished(TSharedRef<const FHRFSearchOutcome> Outcome);
+	EHRFSearchPriority GetSearchPriority() const;
 	FReply OnRefreshClicked();
+	FReply OnSaveSnapshotClicked();
+	FReply OnCompareClicked();
+	FReply OnClearDiffClicked();
+	void OnExplainPathCommitted(const FText& Text, ETextCommit::Type CommitType);
+	void RefreshSizePlatforms();
+	void OnSizePlatformChanged(TSharedPtr<FName> NewPlatform, ESelectInfo::Type SelectInfo);
+	TSharedRef<SWidget> OnGenerateSizePlatformWidget(TSharedPtr<FName> Platform) const;
+	FText GetSizePlatformText(FName Platform) const;
+	FText GetText_SizePlatform() const;
+	void AddPathExplanation();
+	void OnFilterTextChanged(const FText& Text);
+	FReply OnTraceClicked();
+	void OnLoadTraceFinished(const TArray<FHRFLoadEvent>& Events, int32 NumDropped);
+	void AddLoadTrace();
+	FText GetText_Trace() const;
+	EVisibility GetVisibility_Trace() const;
+	const UClass* GetTracedActorClass() const;
+	void RecordHistory();
+	void AddHistory();
+	ECheckBoxState GetCheckState_NodeCosts() const;
+	void OnNodeCostsChanged(ECheckBoxState NewState);
+	EVisibility GetVisibility_NodeCosts() const;
+	EActiveTimerReturnType AttachNodeCosts(double InCurrentTime, float InDeltaTime);
+	ECheckBoxState GetCheckState_SoftReferences() const;
+	void OnSoftReferencesChanged(ECheckBoxState NewState);
+	void ApplyFilter(const TSet<FName>& UserCollapsedPackages);
+	EVisibility GetVisibility_ClearDiff() const;
+	UWorld* GetEditorWorld() const;
+	void OnMapOpened(const FString& Filename, bool bAsTemplate);
+	UBlueprint* GetSearchedBlueprint() const;
+	FName GetSearchedPackageName() const;
 	bool BringAttentionToSCSNode(const FName& SCSIdentifier) const;
 	void OnDoubleClickTreeEntry(TSharedPtr<FHRFTreeViewItem> Item) const;
 	void OnGetChildren(FHRFTreeViewItemPtr InItem, TArray< FHRFTreeViewItemPtr >& OutChildren) const;
@@ -33,9 +85,49 @@ private:
 	
 	/* The graph this window is operating on */
 	TWeakPtr<FBlueprintEditor> BlueprintGraph;
+
+	/* When set the window searches the editor world rather than BlueprintGraph */
+	bool bAnalyzeEditorWorld = false;
+
+	/* When valid the window searches this asset rather than BlueprintGraph */
+	TWeakObjectPtr<UObject> AnalyzedAsset;
 	
-	/* Stores the data from searching the graph for references*/
-	FHardReferenceFinderSearchData SearchData;
+	/* Cooked platform headers are sized with, none for editor sizes. Applies to the next search. */
+	FName SizePlatform = NAME_None;
+
+	/* List the soft dependencies of the searched asset after its hard references */
+	bool bIncludeSoftReferences = false;
+
+	/* The last search FHardReferenceFinderScheduler ran for this window, null until the first one finishes */
+	TSharedPtr<const FHRFSearchOutcome> LastSearch;
+
+	/* Tells the scheduler whether the window can be seen, windows whose tab isn't known are treated as visible */
+	TWeakPtr<SDockTab> OwnerTab;
+
+	/* Snapshot the current results are being compared against, invalid when not diffing */
+	FHardReferenceFinderSnapshot DiffBaseline;
+
+	/* Package whose reference chains are listed at the top of the results, none when not explaining a package */
+	FName ExplainedPackage;
+
+	/* Editor sizes followed by every platform with a cooked registry */
+	TArray<TSharedPtr<FName>> SizePlatforms;
+	TSharedPtr<SComboBox<TSharedPtr<FName>>> SizePlatformCombo;
+
+	/* Records the packages loaded by the next PIE session, compared against the results in AddLoadTrace */
+	FHardReferenceFinderLoadTrace LoadTrace;
+	TArray<FHRFLoadEvent> TraceEvents;
+	int32 NumDroppedTraceEvents = 0;
+
+	/* Every result of the last search, including the diff and path explanation */
+	TArray<FHRFTreeViewItemPtr> SearchResults;
+
+	/* Index used to narrow SearchResults down to TreeViewData as the user types */
+	FHardReferenceFinderFilter Filter;
+	FString FilterText;
+
+	/* Collapsed state of every package when the filter last changed, so hidden packages keep it */
+	TSet<FName> FilteredCollapsedPackages;
 
 	/* Stores the list of items dispalyed by the tree view widget */
 	TArray<TSharedPtr<FHRFTreeViewItem>> TreeViewData;
@@ -43,6 +135,15 @@ private:
 	/* Holds a reference to the header widget */
 	TSharedPtr<STextBlock> HeaderText;
 
+	/* Closure size of the searched asset over time, see FHardReferenceFinderTrendStore */
+	TSharedPtr<SHardReferenceFinderSparkline> HistorySparkline;
+
+	/* Cost of each graph node in the results, drawn over the blueprint's graphs while enabled */
+	TSharedPtr<FHRFNodeCosts> NodeCosts;
+
+	/* Attaches badges to graphs opened after they were enabled */
+	TSharedPtr<FActiveTimerHandle> NodeCostsTimer;
+
 	/* Holds a reference to the tree view*/
 	TSharedPtr<SHRFTreeType> TreeView;
 };